@@ -9,6 +9,8 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.h
         src/crypto/rx/RxConfig.h
         src/crypto/rx/RxDataset.h
+        src/crypto/rx/RxMemoryPlan.h
+        src/crypto/rx/RxPhaseGate.h
         src/crypto/rx/RxQueue.h
         src/crypto/rx/RxSeed.h
         src/crypto/rx/RxVm.h
@@ -38,6 +40,8 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.cpp
         src/crypto/rx/RxConfig.cpp
         src/crypto/rx/RxDataset.cpp
+        src/crypto/rx/RxMemoryPlan.cpp
+        src/crypto/rx/RxPhaseGate.cpp
         src/crypto/rx/RxQueue.cpp
         src/crypto/rx/RxVm.cpp
 		
@@ -91,12 +95,19 @@ if (WITH_RANDOMX)
         set_source_files_properties(src/crypto/randomx/jit_compiler_x86.cpp PROPERTIES COMPILE_FLAGS -Wno-unused-const-variable)
     endif()
 
+    if (XMRIG_OS_LINUX)
+        list(APPEND HEADERS_CRYPTO src/crypto/rx/RxSharedStorage.h)
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxSharedStorage.cpp)
+    endif()
+
     if (WITH_HWLOC)
         list(APPEND HEADERS_CRYPTO
+             src/crypto/rx/RxL3Storage.h
              src/crypto/rx/RxNUMAStorage.h
             )
 
         list(APPEND SOURCES_CRYPTO
+             src/crypto/rx/RxL3Storage.cpp
              src/crypto/rx/RxNUMAStorage.cpp
             )
     endif()
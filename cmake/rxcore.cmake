@@ -0,0 +1,22 @@
+if (WITH_VERIFY_LIB OR WITH_BENCH)
+    if (NOT WITH_RANDOMX)
+        message(FATAL_ERROR "WITH_VERIFY_LIB and WITH_BENCH require WITH_RANDOMX=ON")
+    endif()
+
+    set(SOURCES_RX_CORE "")
+
+    # Only the RandomX core, CPU detection and memory helpers, platform specific files are already selected by the main lists.
+    foreach (source ${HEADERS_BASE} ${SOURCES_BASE} ${SOURCES_BACKEND} ${SOURCES_OS} ${SOURCES_CRYPTO} ${XMRIG_ASM_SOURCES})
+        if (source MATCHES "^src/crypto/randomx/" OR
+            source MATCHES "^src/crypto/rx/Rx(Algo|Cache|Dataset|Fix_[a-z]+|Vm)\\.cpp$" OR
+            source MATCHES "^src/crypto/common/(Assembly|HugePagesInfo|LinuxMemory|MemoryPool|NUMAMemoryPool|VirtualMemory[_a-z]*)\\.cpp$" OR
+            source MATCHES "^src/backend/cpu/(Cpu|CpuThread|CpuThreads|platform/[A-Za-z_]+)\\.cpp$" OR
+            source MATCHES "^src/base/(crypto/Algorithm|io/json/Json[_a-z]*|io/log/Log|io/log/Tags|kernel/Cgroup|kernel/Platform_[a-z]+|tools/String)\\.cpp$" OR
+            source MATCHES "^src/3rdparty/fmt/format\\.cc$")
+            list(APPEND SOURCES_RX_CORE ${source})
+        endif()
+    endforeach()
+
+    add_library(xlarig-rx-core OBJECT ${SOURCES_RX_CORE})
+    set(RX_CORE_LIBRARIES ${ARGON2_LIBRARY} ${UV_LIBRARIES} ${CPUID_LIB} ${EXTRA_LIBS})
+endif()
@@ -36,6 +36,7 @@
 #include "base/io/log/Tags.h"
 #include "base/io/Signals.h"
 #include "base/kernel/Platform.h"
+#include "base/kernel/Process.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "Summary.h"
@@ -44,6 +45,9 @@
 
 xmrig::App::App(Process *process)
 {
+    // Must be set before the first Cpu::info() call, --dry-run always rebuilds the cache.
+    Cpu::setTopologyCache(process->arguments().value("--topology-cache"), process->arguments().hasArg("--dry-run"));
+
     m_controller = std::make_shared<Controller>(process);
 }
 
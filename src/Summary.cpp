@@ -26,11 +26,13 @@
 
 #include <cinttypes>
 #include <cstdio>
+#include <string>
 #include <uv.h>
 
 
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/Cgroup.h"
 #include "base/net/stratum/Pool.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
@@ -172,6 +174,66 @@ static void print_memory(const Config *config)
 }
 
 
+// Compact cpuset list, for example "0-3,8".
+static std::string cpu_list(const std::vector<int32_t> &cpus)
+{
+    std::string out;
+
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        size_t last = i;
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1) {
+            ++last;
+        }
+
+        out += (out.empty() ? "" : ",") + std::to_string(cpus[i]) + (last > i ? "-" + std::to_string(cpus[last]) : "");
+        i = last;
+    }
+
+    return out;
+}
+
+
+static void print_cgroup(const Config *)
+{
+    constexpr size_t oneMiB     = 1024U * 1024U;
+    const auto &cgroup          = Cgroup::process();
+    const uint64_t hugetlb      = cgroup.hugePagesLimit(VirtualMemory::hugePageSize());
+
+    if (!cgroup.isLimited() && hugetlb == Cgroup::kUnlimited) {
+        return;
+    }
+
+    std::string limits;
+    char buf[64] = { 0 };
+
+    if (!cgroup.cpus().empty()) {
+        limits += " cpus " WHITE_BOLD_S + cpu_list(cgroup.cpus()) + CLEAR;
+    }
+
+    if (cgroup.cpuQuota() > 0.0) {
+        snprintf(buf, sizeof(buf), " quota " CYAN_BOLD("%.2f") " CPU", cgroup.cpuQuota());
+        limits += buf;
+    }
+
+    if (cgroup.memory() != Cgroup::kUnlimited) {
+        snprintf(buf, sizeof(buf), " memory " CYAN_BOLD("%" PRIu64) CYAN(" MB"), cgroup.memory() / oneMiB);
+        limits += buf;
+    }
+
+    if (hugetlb != Cgroup::kUnlimited) {
+        snprintf(buf, sizeof(buf), " hugetlb " CYAN_BOLD("%" PRIu64) CYAN(" MB"), hugetlb / oneMiB);
+        limits += buf;
+    }
+
+    if (cgroup.maxThreads() > 0) {
+        snprintf(buf, sizeof(buf), " max threads " CYAN_BOLD("%u"), cgroup.maxThreads());
+        limits += buf;
+    }
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") "%s%s", "CGROUP", cgroup.isV2() ? "v2" : "v1", limits.c_str());
+}
+
+
 static void print_threads(const Config *config)
 {
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") WHITE_BOLD("%s%d%%"),
@@ -220,6 +282,7 @@ void xmrig::Summary::print(Controller *controller)
     print_pages(config);
     print_cpu(config);
     print_memory(config);
+    print_cgroup(config);
     print_threads(config);
     config->pools().print();
 
@@ -44,10 +44,17 @@ class Thread
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Thread)
 
-    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
+    inline Thread(IBackend *backend, size_t id, const T &config, IWorker *worker = nullptr) : m_id(id), m_config(config), m_backend(backend), m_worker(worker) {}
+    inline ~Thread() { join(); delete m_worker; }
 
 #   ifdef XMRIG_OS_APPLE
-    inline ~Thread() { pthread_join(m_thread, nullptr); delete m_worker; }
+    inline void join()
+    {
+        if (m_thread) {
+            pthread_join(m_thread, nullptr);
+            m_thread = {};
+        }
+    }
 
     inline void start(void *(*callback)(void *))
     {
@@ -65,8 +72,7 @@ public:
         }
     }
 #   else
-    inline ~Thread() { m_thread.join(); delete m_worker; }
-
+    inline void join()                              { if (m_thread.joinable()) { m_thread.join(); } }
     inline void start(void *(*callback)(void *))    { m_thread = std::thread(callback, this); }
 #   endif
 
@@ -76,11 +82,14 @@ public:
     inline size_t id() const                        { return m_id; }
     inline void setWorker(IWorker *worker)          { m_worker = worker; }
 
+    // Detaches the worker from a joined thread, so it can be resumed by another one.
+    inline IWorker *takeWorker()                    { IWorker *worker = m_worker; m_worker = nullptr; return worker; }
+
 private:
     const size_t m_id    = 0;
     const T m_config;
     IBackend *m_backend;
-    IWorker *m_worker       = nullptr;
+    IWorker *m_worker;
 
     #ifdef XMRIG_OS_APPLE
     pthread_t m_thread{};
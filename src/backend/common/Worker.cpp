@@ -24,11 +24,29 @@
 
 
 xmrig::Worker::Worker(size_t id, int64_t affinity, int priority) :
+    m_priority(priority),
     m_affinity(affinity),
     m_id(id)
 {
-    m_node = VirtualMemory::bindToNUMANode(affinity);
+    bind();
+}
+
+
+// A parked worker is resumed by a new thread, the bring-up stages were already done by the previous one.
+void xmrig::Worker::resume()
+{
+    bind();
+
+    for (auto &time : m_stageTime) {
+        time.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+void xmrig::Worker::bind()
+{
+    m_node = VirtualMemory::bindToNUMANode(m_affinity);
 
-    Platform::trySetThreadAffinity(affinity);
-    Platform::setThreadPriority(priority);
+    Platform::trySetThreadAffinity(m_affinity);
+    Platform::setThreadPriority(m_priority);
 }
@@ -23,6 +23,9 @@
 #include "backend/common/interfaces/IWorker.h"
 
 
+#include <atomic>
+
+
 namespace xmrig {
 
 
@@ -32,15 +35,23 @@ public:
     Worker(size_t id, int64_t affinity, int priority);
 
 protected:
+    void resume() override;
+
     inline int64_t affinity() const                         { return m_affinity; }
     inline size_t id() const override                       { return m_id; }
     inline uint32_t node() const                            { return m_node; }
+    inline uint64_t stageTime(Stage stage) const override   { return m_stageTime[stage].load(std::memory_order_relaxed); }
+    inline void setStageTime(Stage stage, uint64_t ms)      { m_stageTime[stage].store(ms, std::memory_order_relaxed); }
 
     uint64_t m_count                = 0;
 
 private:
+    void bind();
+
+    const int m_priority;
     const int64_t m_affinity;
     const size_t m_id;
+    std::atomic<uint64_t> m_stageTime[StageMax]{};
     uint32_t m_node                 = 0;
 };
 
@@ -40,11 +40,12 @@ template<size_t N>
 class WorkerJob
 {
 public:
-    inline const Job &currentJob() const    { return m_jobs[index()]; }
+    inline const Job &currentJob() const    { return m_jobs[slot()]; }
     inline uint32_t *nonce(size_t i = 0)    { return reinterpret_cast<uint32_t*>(blob() + (i * currentJob().size()) + nonceOffset()); }
     inline uint64_t sequence() const        { return m_sequence; }
-    inline uint8_t *blob()                  { return m_blobs[index()]; }
+    inline uint8_t *blob()                  { return m_blobs[slot()]; }
     inline uint8_t index() const            { return m_index; }
+    inline void reset()                     { m_sequence = 0; }
 
 
     inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
@@ -55,8 +56,8 @@ public:
             return;
         }
 
-        if (index() == 1 && job.index() == 0 && job == m_jobs[0]) {
-            m_index = 0;
+        if (index() == 1 && job.index() != 1 && job == m_jobs[0]) {
+            m_index = m_jobs[0].index();
             return;
         }
 
@@ -66,9 +67,9 @@ public:
 
     inline bool nextRound(uint32_t rounds, uint32_t roundSize)
     {
-        m_rounds[index()]++;
+        m_rounds[slot()]++;
 
-        if ((m_rounds[index()] & (rounds - 1)) == 0) {
+        if ((m_rounds[slot()] & (rounds - 1)) == 0) {
             for (size_t i = 0; i < N; ++i) {
                 if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask())) {
                     return false;
@@ -86,22 +87,24 @@ public:
 
 
 private:
+    // Donate jobs use the second slot, user jobs (index 0 or a pool partition 2+) share the first one.
+    inline size_t slot() const          { return m_index == 1 ? 1 : 0; }
     inline int32_t nonceOffset() const  { return currentJob().nonceOffset(); }
     inline size_t nonceSize() const     { return currentJob().nonceSize(); }
-    inline uint64_t nonceMask() const     { return m_nonce_mask[index()]; }
+    inline uint64_t nonceMask() const     { return m_nonce_mask[slot()]; }
 
     inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
     {
         m_index           = job.index();
         const size_t size = job.size();
-        m_jobs[index()]   = job;
-        m_rounds[index()] = 0;
-        m_nonce_mask[index()] = job.nonceMask();
+        m_jobs[slot()]    = job;
+        m_rounds[slot()]  = 0;
+        m_nonce_mask[slot()] = job.nonceMask();
 
-        m_jobs[index()].setBackend(backend);
+        m_jobs[slot()].setBackend(backend);
 
         for (size_t i = 0; i < N; ++i) {
-            memcpy(m_blobs[index()] + (i * size), job.blob(), size);
+            memcpy(m_blobs[slot()] + (i * size), job.blob(), size);
             Nonce::next(index(), nonce(i), reserveCount, nonceMask());
         }
     }
@@ -126,16 +129,16 @@ inline uint32_t *xmrig::WorkerJob<1>::nonce(size_t)
 template<>
 inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
 {
-    m_rounds[index()]++;
+    m_rounds[slot()]++;
 
     uint32_t* n = nonce();
 
-    if ((m_rounds[index()] & (rounds - 1)) == 0) {
+    if ((m_rounds[slot()] & (rounds - 1)) == 0) {
         if (!Nonce::next(index(), n, rounds * roundSize, nonceMask())) {
             return false;
         }
         if (nonceSize() == sizeof(uint64_t)) {
-            m_jobs[index()].nonce()[1] = n[1];
+            m_jobs[slot()].nonce()[1] = n[1];
         }
     }
     else {
@@ -150,11 +153,11 @@ template<>
 inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
 {
     m_index           = job.index();
-    m_jobs[index()]   = job;
-    m_rounds[index()] = 0;
-    m_nonce_mask[index()] = job.nonceMask();
+    m_jobs[slot()]    = job;
+    m_rounds[slot()]  = 0;
+    m_nonce_mask[slot()] = job.nonceMask();
 
-    m_jobs[index()].setBackend(backend);
+    m_jobs[slot()].setBackend(backend);
 
     memcpy(blob(), job.blob(), job.size());
     Nonce::next(index(), nonce(), reserveCount, nonceMask());
@@ -57,6 +57,10 @@ xmrig::Workers<T>::Workers() :
 template<class T>
 xmrig::Workers<T>::~Workers()
 {
+    for (auto &threads : m_parked) {
+        release(threads);
+    }
+
     delete d_ptr;
 }
 
@@ -108,19 +112,32 @@ void xmrig::Workers<T>::setBackend(IBackend *backend)
 }
 
 
+// With warm pools the stopped workers keep their memory and are parked, the most recently used set comes first.
 template<class T>
-void xmrig::Workers<T>::stop()
+void xmrig::Workers<T>::stop(uint32_t warmPools)
 {
 #   ifdef XMRIG_MINER_PROJECT
     Nonce::stop(T::backend());
 #   endif
 
-    for (Thread<T> *worker : m_workers) {
-        delete worker;
+    if (warmPools > 0 && !d_ptr->benchmark && !m_workers.empty()) {
+        for (Thread<T> *handle : m_workers) {
+            handle->join();
+        }
+
+        m_parked.insert(m_parked.begin(), m_workers);
+    }
+    else {
+        release(m_workers);
     }
 
     m_workers.clear();
 
+    while (m_parked.size() > warmPools) {
+        release(m_parked.back());
+        m_parked.pop_back();
+    }
+
 #   ifdef XMRIG_MINER_PROJECT
     Nonce::touch(T::backend());
 #   endif
@@ -129,6 +146,17 @@ void xmrig::Workers<T>::stop()
 }
 
 
+template<class T>
+void xmrig::Workers<T>::release(std::vector<Thread<T> *> &threads)
+{
+    for (Thread<T> *handle : threads) {
+        delete handle;
+    }
+
+    threads.clear();
+}
+
+
 template<class T>
 xmrig::IWorker *xmrig::Workers<T>::create(Thread<T> *)
 {
@@ -141,6 +169,13 @@ void *xmrig::Workers<T>::onReady(void *arg)
 {
     auto handle = static_cast<Thread<T>* >(arg);
 
+    if (handle->worker()) {
+        handle->worker()->resume();
+        handle->backend()->start(handle->worker(), true);
+
+        return nullptr;
+    }
+
     IWorker *worker = create(handle);
     assert(worker != nullptr);
 
@@ -162,11 +197,32 @@ void *xmrig::Workers<T>::onReady(void *arg)
 }
 
 
+// Index of the parked set which can resume the threads, or m_parked.size() if there is none.
+template<class T>
+size_t xmrig::Workers<T>::parked(const std::vector<T> &data) const
+{
+    auto warm = std::find_if(m_parked.begin(), m_parked.end(), [&data](const std::vector<Thread<T> *> &threads) {
+        return threads.size() == data.size() && std::equal(data.begin(), data.end(), threads.begin(), [](const T &item, const Thread<T> *handle) {
+            return item.isResumable(handle->config());
+        });
+    });
+
+    return static_cast<size_t>(warm - m_parked.begin());
+}
+
+
 template<class T>
 void xmrig::Workers<T>::start(const std::vector<T> &data, bool sleep)
 {
-    for (const auto &item : data) {
-        m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
+    auto warm = m_parked.begin() + static_cast<std::ptrdiff_t>(parked(data));
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        m_workers.push_back(new Thread<T>(d_ptr->backend, i, data[i], warm != m_parked.end() ? (*warm)[i]->takeWorker() : nullptr));
+    }
+
+    if (warm != m_parked.end()) {
+        release(*warm);
+        m_parked.erase(warm);
     }
 
     d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
@@ -24,6 +24,9 @@
 #include "backend/cpu/CpuLaunchData.h"
 
 
+#include <algorithm>
+
+
 #ifdef XMRIG_FEATURE_OPENCL
 #   include "backend/opencl/OclLaunchData.h"
 #endif
@@ -51,13 +54,15 @@ public:
     Workers();
     ~Workers();
 
-    inline void start(const std::vector<T> &data)   { start(data, true); }
+    inline bool isParked(const std::vector<T> &data) const  { return parked(data) < m_parked.size(); }
+    inline void start(const std::vector<T> &data)           { start(data, true); }
 
     bool tick(uint64_t ticks);
     const Hashrate *hashrate() const;
+    uint64_t stageTime(IWorker::Stage stage) const;
     void jobEarlyNotification(const Job &job);
     void setBackend(IBackend *backend);
-    void stop();
+    void stop(uint32_t warmPools = 0);
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     void start(const std::vector<T> &data, const std::shared_ptr<Benchmark> &benchmark);
@@ -67,8 +72,12 @@ private:
     static IWorker *create(Thread<T> *handle);
     static void *onReady(void *arg);
 
+    static void release(std::vector<Thread<T> *> &threads);
+
+    size_t parked(const std::vector<T> &data) const;
     void start(const std::vector<T> &data, bool sleep);
 
+    std::vector<std::vector<Thread<T> *> > m_parked;
     std::vector<Thread<T> *> m_workers;
     WorkersPrivate *d_ptr;
 };
@@ -85,6 +94,22 @@ void xmrig::Workers<T>::jobEarlyNotification(const Job &job)
 }
 
 
+// The slowest worker defines when the backend is ready.
+template<class T>
+uint64_t xmrig::Workers<T>::stageTime(IWorker::Stage stage) const
+{
+    uint64_t out = 0;
+
+    for (const Thread<T> *t : m_workers) {
+        if (t->worker()) {
+            out = std::max(out, t->worker()->stageTime(stage));
+        }
+    }
+
+    return out;
+}
+
+
 template<>
 IWorker *Workers<CpuLaunchData>::create(Thread<CpuLaunchData> *handle);
 extern template class Workers<CpuLaunchData>;
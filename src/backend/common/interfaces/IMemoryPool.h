@@ -40,6 +40,7 @@ public:
 
     virtual bool isHugePages(uint32_t node) const       = 0;
     virtual uint8_t *get(size_t size, uint32_t node)    = 0;
+    virtual void prepare(uint32_t node)                 = 0;
     virtual void release(uint32_t node)                 = 0;
 };
 
@@ -39,6 +39,15 @@ class IWorker
 public:
     XMRIG_DISABLE_COPY_MOVE(IWorker)
 
+    // Worker bring-up stages, the time of each one is exposed in the API.
+    enum Stage : uint32_t {
+        AllocStage,
+        FaultStage,
+        SelfTestStage,
+        JitStage,
+        StageMax
+    };
+
     IWorker()           = default;
     virtual ~IWorker()  = default;
 
@@ -46,8 +55,10 @@ public:
     virtual const VirtualMemory *memory() const                                                     = 0;
     virtual size_t id() const                                                                       = 0;
     virtual size_t intensity() const                                                                = 0;
+    virtual uint64_t stageTime(Stage stage) const                                                   = 0;
     virtual void hashrateData(uint64_t &hashCount, uint64_t &timeStamp, uint64_t &rawHashes) const  = 0;
     virtual void jobEarlyNotification(const Job &job)                                               = 0;
+    virtual void resume()                                                                           = 0;
     virtual void start()                                                                            = 0;
 };
 
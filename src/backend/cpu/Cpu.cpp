@@ -17,11 +17,13 @@
  */
 
 
+#include <algorithm>
 #include <cassert>
 
 
 #include "backend/cpu/Cpu.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/kernel/Cgroup.h"
 
 
 #if defined(XMRIG_FEATURE_HWLOC)
@@ -48,6 +50,38 @@ xmrig::ICpuInfo *xmrig::Cpu::info()
 }
 
 
+// Autoconfig for the cgroup of the process: only CPUs of its cpuset and no more threads than its CPU quota.
+xmrig::CpuThreads xmrig::Cpu::threads(const Algorithm &algorithm, uint32_t limit)
+{
+    const auto &cgroup = Cgroup::process();
+    const uint32_t max = cgroup.maxThreads();
+    if (max == 0) {
+        return info()->threads(algorithm, limit);
+    }
+
+    // The quota lowers max-threads-hint rather than cutting the list, so that threads are still spread over caches and cores.
+    const auto total = static_cast<uint32_t>(info()->threads());
+    if (max < total) {
+        const uint32_t hint = (max * 100 + total - 1) / total;
+
+        limit = limit > 0 && limit < 100 ? std::min(limit, hint) : hint;
+    }
+
+    const CpuThreads threads = info()->threads(algorithm, limit);
+    CpuThreads out;
+    out.reserve(max);
+
+    for (const auto &thread : threads.data()) {
+        if (out.count() < max && cgroup.isAllowed(thread.affinity())) {
+            out.add(CpuThread(thread));
+        }
+    }
+
+    // The topology doesn't match the cpuset (for example a cached one), let the kernel place the threads.
+    return out.isEmpty() ? CpuThreads(std::min<size_t>(max, std::max<size_t>(threads.count(), 1))) : out;
+}
+
+
 rapidjson::Value xmrig::Cpu::toJSON(rapidjson::Document &doc)
 {
     return info()->toJSON(doc);
@@ -59,3 +93,14 @@ void xmrig::Cpu::release()
     delete cpuInfo;
     cpuInfo = nullptr;
 }
+
+
+void xmrig::Cpu::setTopologyCache(const char *path, bool refresh)
+{
+#   if defined(XMRIG_FEATURE_HWLOC)
+    HwlocCpuInfo::setCache(path, refresh);
+#   else
+    (void) path;
+    (void) refresh;
+#   endif
+}
@@ -29,9 +29,11 @@ namespace xmrig {
 class Cpu
 {
 public:
+    static CpuThreads threads(const Algorithm &algorithm, uint32_t limit);
     static ICpuInfo *info();
     static rapidjson::Value toJSON(rapidjson::Document &doc);
     static void release();
+    static void setTopologyCache(const char *path, bool refresh);
 
     inline static Assembly::Id assembly(Assembly::Id hint) { return hint == Assembly::AUTO ? Cpu::info()->assembly() : hint; }
 };
@@ -27,6 +27,8 @@
 
 
 #include "backend/cpu/CpuBackend.h"
+#include "backend/cpu/CpuMemory.h"
+#include "backend/cpu/CpuSelfTest.h"
 #include "3rdparty/rapidjson/document.h"
 #include "backend/common/Hashrate.h"
 #include "backend/common/interfaces/IWorker.h"
@@ -40,6 +42,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -78,17 +81,19 @@ public:
     inline size_t memory() const                    { return m_ways * m_memory; }
     inline size_t threads() const                   { return m_threads; }
     inline size_t ways() const                      { return m_ways; }
+    inline uint64_t readyTime() const               { return m_readyTime; }
 
     inline void start(const std::vector<CpuLaunchData> &threads, size_t memory)
     {
         m_workersMemory.clear();
         m_hugePages.reset();
-        m_memory    = memory;
-        m_started   = 0;
-        m_errors    = 0;
-        m_threads   = threads.size();
-        m_ways      = 0;
-        m_ts        = Chrono::steadyMSecs();
+        m_memory        = memory;
+        m_started       = 0;
+        m_errors        = 0;
+        m_threads       = threads.size();
+        m_ways          = 0;
+        m_ts            = Chrono::steadyMSecs();
+        m_readyTime     = 0;
     }
 
     inline bool started(IWorker *worker, bool ready)
@@ -105,7 +110,13 @@ public:
             m_errors++;
         }
 
-        return (m_started + m_errors) == m_threads;
+        if ((m_started + m_errors) == m_threads) {
+            m_readyTime = Chrono::steadyMSecs() - m_ts;
+
+            return true;
+        }
+
+        return false;
     }
 
     inline void print() const
@@ -124,19 +135,20 @@ public:
                  m_hugePages.percent(),
                  m_hugePages.allocated, m_hugePages.total,
                  memory() / 1024,
-                 Chrono::steadyMSecs() - m_ts
+                 m_readyTime
                  );
     }
 
 private:
     std::set<const VirtualMemory*> m_workersMemory;
     HugePagesInfo m_hugePages;
-    size_t m_errors       = 0;
-    size_t m_memory       = 0;
-    size_t m_started      = 0;
-    size_t m_threads      = 0;
-    size_t m_ways         = 0;
-    uint64_t m_ts         = 0;
+    size_t m_errors         = 0;
+    size_t m_memory         = 0;
+    size_t m_started        = 0;
+    size_t m_threads        = 0;
+    size_t m_ways           = 0;
+    uint64_t m_readyTime    = 0;
+    uint64_t m_ts           = 0;
 };
 
 
@@ -156,7 +168,13 @@ public:
                  algo.l3() / 1024
                  );
 
-        status.start(threads, algo.l3());
+        status.start(threads, CpuMemory::size(algo));
+
+        // A resumed parked set already has its memory and passed its self-test.
+        if (!workers.isParked(threads)) {
+            CpuMemory::prepare(threads);
+            CpuSelfTest::start(threads);
+        }
 
 #       ifdef XMRIG_FEATURE_BENCHMARK
         workers.start(threads, benchmark);
@@ -205,6 +223,53 @@ public:
     }
 
 
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value kindsHashrate(size_t kinds, const Hashrate *hashrate, rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        static const size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+        Value out(kArrayType);
+
+        for (uint32_t kind = 0; kind < kinds; ++kind) {
+            double total[3] = { 0.0 };
+            uint64_t count  = 0;
+
+            for (size_t i = 0; i < threads.size(); ++i) {
+                if (Cpu::info()->coreKind(threads[i].affinity) != kind) {
+                    continue;
+                }
+
+                ++count;
+
+                for (size_t j = 0; j < 3; ++j) {
+                    const double h = hashrate->calc(i, intervals[j]);
+                    if (std::isnormal(h)) {
+                        total[j] += h;
+                    }
+                }
+            }
+
+            Value hr(kArrayType);
+            for (double h : total) {
+                hr.PushBack(Hashrate::normalize(h), allocator);
+            }
+
+            Value item(kObjectType);
+            item.AddMember("kind",      kind, allocator);
+            item.AddMember("threads",   count, allocator);
+            item.AddMember("hashrate",  hr, allocator);
+
+            out.PushBack(item, allocator);
+        }
+
+        return out;
+    }
+#   endif
+
+
     Algorithm algo;
     Controller *controller;
     CpuLaunchStatus status;
@@ -255,6 +320,9 @@ xmrig::CpuBackend::CpuBackend(Controller *controller) :
 xmrig::CpuBackend::~CpuBackend()
 {
     delete d_ptr;
+
+    CpuMemory::release();
+    CpuSelfTest::release();
 }
 
 
@@ -355,9 +423,13 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
-    const auto &cpu = d_ptr->controller->config()->cpu();
+    const auto &cpu     = d_ptr->controller->config()->cpu();
+    const auto weights  = d_ptr->controller->config()->pools().weights();
+    const auto miner    = d_ptr->controller->miner();
 
-    auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
+    // Weighted pools split the threads between their jobs, a donate job takes all of them.
+    const bool split = !weights.empty() && job.index() != 1;
+    auto threads     = split ? cpu.get(miner, miner->partitionAlgorithms(weights.size()), weights) : cpu.get(miner, job.algorithm());
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
     }
@@ -408,9 +480,12 @@ void xmrig::CpuBackend::stop()
 
     const uint64_t ts = Chrono::steadyMSecs();
 
-    d_ptr->workers.stop();
+    d_ptr->workers.stop(d_ptr->controller->config()->cpu().warmPools());
     d_ptr->threads.clear();
 
+    CpuMemory::release();
+    CpuSelfTest::release();
+
     LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::cpu(), Chrono::steadyMSecs() - ts);
 }
 
@@ -431,6 +506,18 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("priority",   cpu.priority(), allocator);
     out.AddMember("msr",        Rx::isMSR(), allocator);
 
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (d_ptr->algo.family() == Algorithm::RANDOM_X) {
+        const auto seedCache = Rx::seedCache();
+
+        Value seeds(kObjectType);
+        seeds.AddMember("hits",     seedCache.first, allocator);
+        seeds.AddMember("misses",   seedCache.second, allocator);
+
+        out.AddMember("seed_cache", seeds, allocator);
+    }
+#   endif
+
 #   ifdef XMRIG_FEATURE_ASM
     const Assembly assembly = Cpu::assembly(cpu.assembly());
     out.AddMember("asm", assembly.toJSON(), allocator);
@@ -447,7 +534,7 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 #   endif
 
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
-    out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
+    out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * CpuMemory::size(d_ptr->algo)) : 0), allocator);
 
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
@@ -455,7 +542,20 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("hashrate", hashrate()->toJSON(doc), allocator);
 
+    Value ready(kObjectType);
+    mutex.lock();
+    ready.AddMember("total",     d_ptr->status.readyTime(), allocator);
+    mutex.unlock();
+    ready.AddMember("prepare",   CpuMemory::prepareTime(), allocator);
+    ready.AddMember("alloc",     d_ptr->workers.stageTime(IWorker::AllocStage), allocator);
+    ready.AddMember("fault",     d_ptr->workers.stageTime(IWorker::FaultStage), allocator);
+    ready.AddMember("self_test", d_ptr->workers.stageTime(IWorker::SelfTestStage), allocator);
+    ready.AddMember("jit",       d_ptr->workers.stageTime(IWorker::JitStage), allocator);
+
+    out.AddMember("ready", ready, allocator);
+
     Value threads(kArrayType);
+    const size_t kinds = Cpu::info()->coreKinds();
 
     size_t i = 0;
     for (const CpuLaunchData &data : d_ptr->threads) {
@@ -465,12 +565,20 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
 
+        if (kinds > 1) {
+            thread.AddMember("kind",    Cpu::info()->coreKind(data.affinity), allocator);
+        }
+
         i++;
         threads.PushBack(thread, allocator);
     }
 
     out.AddMember("threads", threads, allocator);
 
+    if (kinds > 1) {
+        out.AddMember("kinds", d_ptr->kindsHashrate(kinds, hashrate(), doc), allocator);
+    }
+
     return out;
 }
 
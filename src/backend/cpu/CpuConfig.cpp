@@ -36,6 +36,8 @@ const char *CpuConfig::kHwAes               = "hw-aes";
 const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
 const char *CpuConfig::kPriority            = "priority";
+const char *CpuConfig::kSmtPhase            = "smt-phase";
+const char *CpuConfig::kWarmPools           = "warm-pools";
 const char *CpuConfig::kYield               = "yield";
 
 #ifdef XMRIG_FEATURE_ASM
@@ -77,6 +79,8 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kSmtPhase),     m_smtPhase, allocator);
+    obj.AddMember(StringRef(kWarmPools),    m_warmPools, allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -127,6 +131,56 @@ std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, cons
 }
 
 
+// Weighted pools: partition N takes its share of the threads from the profile of its own algorithm,
+// the shares are cut at the same relative positions so that the partitions end up on different cores.
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const std::vector<Algorithm> &algorithms, const std::vector<uint32_t> &weights) const
+{
+    std::vector<CpuLaunchData> out;
+    std::vector<std::pair<size_t, size_t> > slices(weights.size());
+
+    uint64_t total = 0;
+    for (uint32_t weight : weights) {
+        total += weight;
+    }
+
+    if (total == 0 || algorithms.size() != weights.size()) {
+        return out;
+    }
+
+    size_t count    = 0;
+    uint64_t before = 0;
+
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const size_t size = m_threads.get(algorithms[i]).count();
+        const uint64_t after = before + weights[i];
+
+        auto &slice  = slices[i];
+        slice.first  = static_cast<size_t>((size * before + total / 2) / total);
+        slice.second = static_cast<size_t>((size * after + total / 2) / total);
+
+        if (slice.second <= slice.first && size > 0) {
+            slice.first  = std::min(slice.first, size - 1);
+            slice.second = slice.first + 1;
+        }
+
+        count += slice.second - slice.first;
+        before = after;
+    }
+
+    out.reserve(count);
+
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const auto &threads = m_threads.get(algorithms[i]).data();
+
+        for (size_t j = slices[i].first; j < slices[i].second; ++j) {
+            out.emplace_back(miner, algorithms[i], *this, threads[j], count, static_cast<uint32_t>(i));
+        }
+    }
+
+    return out;
+}
+
+
 void xmrig::CpuConfig::read(const rapidjson::Value &value)
 {
     if (value.IsObject()) {
@@ -134,6 +188,8 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_smtPhase     = Json::getBool(value, kSmtPhase, m_smtPhase);
+        m_warmPools    = Json::getUint(value, kWarmPools, m_warmPools);
 
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
@@ -46,6 +46,8 @@ public:
     static const char *kMaxThreadsHint;
     static const char *kMemoryPool;
     static const char *kPriority;
+    static const char *kSmtPhase;
+    static const char *kWarmPools;
     static const char *kYield;
 
 #   ifdef XMRIG_FEATURE_ASM
@@ -67,6 +69,7 @@ public:
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t memPoolSize() const;
     std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
+    std::vector<CpuLaunchData> get(const Miner *miner, const std::vector<Algorithm> &algorithms, const std::vector<uint32_t> &weights) const;
     void read(const rapidjson::Value &value);
 
     inline bool astrobwtAVX2() const                    { return m_astrobwtAVX2; }
@@ -74,6 +77,7 @@ public:
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
+    inline bool isSmtPhase() const                      { return m_smtPhase; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
@@ -82,6 +86,7 @@ public:
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
     inline uint32_t limit() const                       { return m_limit; }
+    inline uint32_t warmPools() const                   { return m_warmPools; }
 
 private:
     constexpr static size_t kDefaultHugePageSizeKb  = 2048U;
@@ -100,6 +105,7 @@ private:
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
     bool m_shouldSave       = false;
+    bool m_smtPhase         = false;
     bool m_yield            = true;
     int m_astrobwtMaxSize   = 550;
     int m_memoryPool        = 0;
@@ -108,6 +114,7 @@ private:
     String m_argon2Impl;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
+    uint32_t m_warmPools    = 0;
 };
 
 
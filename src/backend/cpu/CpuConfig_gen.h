@@ -41,7 +41,7 @@ static inline size_t generate(const char *key, Threads<CpuThreads> &threads, con
         return 0;
     }
 
-    return threads.move(key, Cpu::info()->threads(algorithm, limit));
+    return threads.move(key, Cpu::threads(algorithm, limit));
 }
 
 
@@ -106,11 +106,10 @@ template<>
 size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32_t limit)
 {
     size_t count = 0;
-    auto cpuInfo = Cpu::info();
-    auto wow     = cpuInfo->threads(Algorithm::RX_WOW, limit);
+    auto wow     = Cpu::threads(Algorithm::RX_WOW, limit);
 
     if (!threads.isExist(Algorithm::RX_ARQ)) {
-        auto arq = cpuInfo->threads(Algorithm::RX_ARQ, limit);
+        auto arq = Cpu::threads(Algorithm::RX_ARQ, limit);
         if (arq == wow) {
             threads.setAlias(Algorithm::RX_ARQ, "rx/wow");
             ++count;
@@ -121,7 +120,7 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
     }
 
     if (!threads.isExist(Algorithm::RX_KEVA)) {
-        auto keva = cpuInfo->threads(Algorithm::RX_KEVA, limit);
+        auto keva = Cpu::threads(Algorithm::RX_KEVA, limit);
         if (keva == wow) {
             threads.setAlias(Algorithm::RX_KEVA, "rx/wow");
             ++count;
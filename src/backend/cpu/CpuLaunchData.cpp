@@ -32,19 +32,21 @@
 #include <algorithm>
 
 
-xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads) :
+xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, uint32_t partition) :
     algorithm(algorithm),
     assembly(config.assembly()),
     astrobwtAVX2(config.astrobwtAVX2()),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    smtPhase(config.isSmtPhase()),
     yield(config.isYield()),
     astrobwtMaxSize(config.astrobwtMaxSize()),    
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
     threads(threads),
-    intensity(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity()))
+    intensity(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity())),
+    partition(partition)
 {
 }
 
@@ -57,7 +59,23 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && hwAES            == other.hwAES
             && intensity        == other.intensity
             && priority         == other.priority
+            && smtPhase         == other.smtPhase
             && affinity         == other.affinity
+            && partition        == other.partition
+            );
+}
+
+
+// A parked worker keeps everything it was created with, so it can only be resumed with exactly the same launch data.
+bool xmrig::CpuLaunchData::isResumable(const CpuLaunchData &other) const
+{
+    return (isEqual(other)
+            && algorithm        == other.algorithm
+            && astrobwtAVX2     == other.astrobwtAVX2
+            && yield            == other.yield
+            && astrobwtMaxSize  == other.astrobwtMaxSize
+            && miner            == other.miner
+            && threads          == other.threads
             );
 }
 
@@ -44,9 +44,10 @@ class Miner;
 class CpuLaunchData
 {
 public:
-    CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads);
+    CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, uint32_t partition = 0);
 
     bool isEqual(const CpuLaunchData &other) const;
+    bool isResumable(const CpuLaunchData &other) const;
     CnHash::AlgoVariant av() const;
 
     inline constexpr static Nonce::Backend backend()            { return Nonce::CPU; }
@@ -61,6 +62,7 @@ public:
     const bool astrobwtAVX2;
     const bool hugePages;
     const bool hwAES;
+    const bool smtPhase;
     const bool yield;
     const int astrobwtMaxSize;
     const int priority;
@@ -68,6 +70,7 @@ public:
     const Miner *miner;
     const size_t threads;
     const uint32_t intensity;
+    const uint32_t partition;
 };
 
 
@@ -0,0 +1,190 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/CpuMemory.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuLaunchData.h"
+#include "base/tools/Chrono.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxMemoryPlan.h"
+#endif
+
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+namespace xmrig {
+
+
+struct CpuMemoryItem
+{
+    size_t id;
+    size_t size;
+    bool hugePages;
+};
+
+
+struct CpuMemorySlot
+{
+    bool ready              = false;
+    bool taken              = false;
+    uint64_t allocTime      = 0;
+    uint64_t faultTime      = 0;
+    VirtualMemory *memory   = nullptr;
+};
+
+
+static std::atomic<uint64_t> prepareMs{0};
+static std::condition_variable cv;
+static std::mutex mutex;
+static std::vector<CpuMemorySlot> slots;
+static std::vector<std::thread> helpers;
+static size_t pending   = 0;
+static uint64_t startTs = 0;
+
+
+// Runs with the memory policy of the node, so pages faulted in here are local to the workers which take them.
+static void onHelper(uint32_t node, int64_t affinity, const std::vector<CpuMemoryItem> &items)
+{
+    const uint32_t bound = VirtualMemory::bindToNUMANode(affinity);
+    VirtualMemory::preparePool(node);
+
+    for (const auto &item : items) {
+        uint64_t ts = Chrono::steadyMSecs();
+        auto memory = new VirtualMemory(item.size, item.hugePages, false, true, bound);
+
+        const uint64_t allocTime = Chrono::steadyMSecs() - ts;
+
+        ts = Chrono::steadyMSecs();
+        memory->prefault();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &slot      = slots[item.id];
+        slot.memory     = memory;
+        slot.allocTime  = allocTime;
+        slot.faultTime  = Chrono::steadyMSecs() - ts;
+        slot.ready      = true;
+
+        cv.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--pending == 0) {
+        prepareMs = Chrono::steadyMSecs() - startTs;
+    }
+}
+
+
+} // namespace xmrig
+
+
+// Per-thread memory of one hash, Panthera keeps its yespower working set next to the scratchpad.
+size_t xmrig::CpuMemory::size(const Algorithm &algorithm)
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    return RxMemoryPlan::size(algorithm);
+#   else
+    return algorithm.l3();
+#   endif
+}
+
+
+uint64_t xmrig::CpuMemory::prepareTime()
+{
+    return prepareMs.load(std::memory_order_relaxed);
+}
+
+
+// Waits until the helper of the worker's node has prepared its memory, returns nullptr if nothing was prepared for it.
+xmrig::VirtualMemory *xmrig::CpuMemory::take(size_t id, uint64_t &allocTime, uint64_t &faultTime)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (id >= slots.size()) {
+        return nullptr;
+    }
+
+    auto &slot = slots[id];
+    cv.wait(lock, [&slot] { return slot.ready; });
+
+    slot.taken = true;
+    allocTime  = slot.allocTime;
+    faultTime  = slot.faultTime;
+
+    return slot.memory;
+}
+
+
+// Starts one helper per NUMA node used by the threads and returns immediately, workers wait only for their own memory.
+void xmrig::CpuMemory::prepare(const std::vector<CpuLaunchData> &threads)
+{
+    release();
+
+    std::map<uint32_t, std::pair<int64_t, std::vector<CpuMemoryItem> > > nodes;
+    for (size_t i = 0; i < threads.size(); ++i) {
+        const auto &data = threads[i];
+        auto &node       = nodes[Cpu::info()->node(data.affinity)];
+
+        if (node.second.empty()) {
+            node.first = data.affinity;
+        }
+
+        node.second.push_back({ i, size(data.algorithm) * data.intensity, data.hugePages });
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    slots.assign(threads.size(), CpuMemorySlot());
+    pending                 = nodes.size();
+    startTs                 = Chrono::steadyMSecs();
+    prepareMs               = 0;
+
+    helpers.reserve(nodes.size());
+
+    for (const auto &kv : nodes) {
+        helpers.emplace_back(onHelper, kv.first, kv.second.first, kv.second.second);
+    }
+}
+
+
+// Called after the workers are stopped: they have taken their memory by then, so the helpers are already done.
+void xmrig::CpuMemory::release()
+{
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+
+    helpers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &slot : slots) {
+        if (!slot.taken) {
+            delete slot.memory;
+        }
+    }
+
+    slots.clear();
+}
@@ -0,0 +1,52 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUMEMORY_H
+#define XMRIG_CPUMEMORY_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class CpuLaunchData;
+class VirtualMemory;
+
+
+// Memory of the CPU workers, reserved and faulted in by one helper thread per NUMA node while the workers start.
+class CpuMemory
+{
+public:
+    static size_t size(const Algorithm &algorithm);
+    static uint64_t prepareTime();
+    static VirtualMemory *take(size_t id, uint64_t &allocTime, uint64_t &faultTime);
+    static void prepare(const std::vector<CpuLaunchData> &threads);
+    static void release();
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUMEMORY_H */
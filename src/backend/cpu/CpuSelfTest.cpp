@@ -0,0 +1,278 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/CpuSelfTest.h"
+#include "backend/cpu/CpuLaunchData.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CryptoNight_test.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+namespace xmrig {
+
+
+enum SelfTestState : int {
+    SelfTestRunning,
+    SelfTestPassed,
+    SelfTestFailed
+};
+
+
+static std::condition_variable cv;
+static std::map<uint64_t, SelfTestState> results;
+static std::mutex mutex;
+static std::vector<std::thread> helpers;
+
+
+// Results are shared by all threads with the same hash function.
+static inline uint64_t key(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly, bool astrobwtAVX2)
+{
+    return (static_cast<uint64_t>(algorithm.family()) << 32) | (static_cast<uint64_t>(av) << 16) | (static_cast<uint64_t>(assembly) << 8) | (astrobwtAVX2 ? 1 : 0);
+}
+
+
+template<size_t N>
+class CpuSelfTestRunner
+{
+public:
+    inline CpuSelfTestRunner(CnHash::AlgoVariant av, Assembly::Id assembly, cryptonight_ctx **ctx) : m_assembly(assembly), m_av(av), m_ctx(ctx) {}
+
+    bool run(const Algorithm &algorithm, bool full);
+
+private:
+    bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
+    bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
+
+    alignas(16) uint8_t m_blob[N * sizeof(cn_r_test_input[0].data)]{ 0 };
+    alignas(16) uint8_t m_hash[N * 32]{ 0 };
+    Assembly::Id m_assembly;
+    CnHash::AlgoVariant m_av;
+    cryptonight_ctx **m_ctx;
+};
+
+
+template<size_t N>
+bool CpuSelfTestRunner<N>::run(const Algorithm &algorithm, bool full)
+{
+    if (algorithm.family() == Algorithm::CN) {
+        return verify(Algorithm::CN_0, test_output_v0) && (!full || (
+               verify(Algorithm::CN_1,      test_output_v1)   &&
+               verify(Algorithm::CN_2,      test_output_v2)   &&
+               verify(Algorithm::CN_FAST,   test_output_msr)  &&
+               verify(Algorithm::CN_XAO,    test_output_xao)  &&
+               verify(Algorithm::CN_RTO,    test_output_rto)  &&
+               verify(Algorithm::CN_HALF,   test_output_half) &&
+               verify2(Algorithm::CN_R,     test_output_r)    &&
+               verify(Algorithm::CN_RWZ,    test_output_rwz)  &&
+               verify(Algorithm::CN_ZLS,    test_output_zls)  &&
+               verify(Algorithm::CN_CCX,    test_output_ccx)  &&
+               verify(Algorithm::CN_DOUBLE, test_output_double)));
+    }
+
+#   ifdef XMRIG_ALGO_CN_LITE
+    if (algorithm.family() == Algorithm::CN_LITE) {
+        return verify(Algorithm::CN_LITE_0, test_output_v0_lite) && (!full ||
+               verify(Algorithm::CN_LITE_1, test_output_v1_lite));
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    if (algorithm.family() == Algorithm::CN_HEAVY) {
+        return verify(Algorithm::CN_HEAVY_0, test_output_v0_heavy) && (!full || (
+               verify(Algorithm::CN_HEAVY_XHV,  test_output_xhv_heavy) &&
+               verify(Algorithm::CN_HEAVY_TUBE, test_output_tube_heavy)));
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_CN_PICO
+    if (algorithm.family() == Algorithm::CN_PICO) {
+        return verify(Algorithm::CN_PICO_0, test_output_pico_trtl) && (!full ||
+               verify(Algorithm::CN_PICO_TLO, test_output_pico_tlo));
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_ARGON2
+    if (algorithm.family() == Algorithm::ARGON2) {
+        return verify(Algorithm::AR2_CHUKWA, argon2_chukwa_test_out) && (!full || (
+               verify(Algorithm::AR2_CHUKWA_V2, argon2_chukwa_v2_test_out) &&
+               verify(Algorithm::AR2_WRKZ, argon2_wrkz_test_out)));
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_ASTROBWT
+    if (algorithm.family() == Algorithm::ASTROBWT) {
+        return verify(Algorithm::ASTROBWT_DERO, astrobwt_dero_test_out);
+    }
+#   endif
+
+    return false;
+}
+
+
+template<size_t N>
+bool CpuSelfTestRunner<N>::verify(const Algorithm &algorithm, const uint8_t *referenceValue)
+{
+    cn_hash_fun func = CnHash::fn(algorithm, m_av, m_assembly);
+    if (!func) {
+        return false;
+    }
+
+    func(test_input, 76, m_hash, m_ctx, 0);
+    return memcmp(m_hash, referenceValue, sizeof m_hash) == 0;
+}
+
+
+template<size_t N>
+bool CpuSelfTestRunner<N>::verify2(const Algorithm &algorithm, const uint8_t *referenceValue)
+{
+    cn_hash_fun func = CnHash::fn(algorithm, m_av, m_assembly);
+    if (!func) {
+        return false;
+    }
+
+    for (size_t i = 0; i < (sizeof(cn_r_test_input) / sizeof(cn_r_test_input[0])); ++i) {
+        const size_t size = cn_r_test_input[i].size;
+        for (size_t k = 0; k < N; ++k) {
+            memcpy(m_blob + (k * size), cn_r_test_input[i].data, size);
+        }
+
+        func(m_blob, size, m_hash, m_ctx, cn_r_test_input[i].height);
+
+        for (size_t k = 0; k < N; ++k) {
+            if (memcmp(m_hash + k * 32, referenceValue + i * 32, sizeof m_hash / N) != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// The full test has its own scratchpad, so it runs while the helpers of CpuMemory still reserve the workers' memory.
+static void onHelper(uint64_t id, const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly, size_t ways)
+{
+    cryptonight_ctx *ctx[5] = {};
+
+    VirtualMemory memory(algorithm.l3() * ways, false, false, false);
+    bool rc = memory.scratchpad() != nullptr;
+
+    if (rc) {
+        CnCtx::create(ctx, memory.scratchpad(), algorithm.l3(), ways);
+        rc = CpuSelfTest::check(algorithm, av, assembly, ctx, ways, true);
+        CnCtx::release(ctx, ways);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    results[id] = rc ? SelfTestPassed : SelfTestFailed;
+
+    cv.notify_all();
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::CpuSelfTest::check(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly, cryptonight_ctx **ctx, size_t ways, bool full)
+{
+    switch (ways) {
+    case 1:
+        return CpuSelfTestRunner<1>(av, assembly, ctx).run(algorithm, full);
+
+    case 2:
+        return CpuSelfTestRunner<2>(av, assembly, ctx).run(algorithm, full);
+
+    case 3:
+        return CpuSelfTestRunner<3>(av, assembly, ctx).run(algorithm, full);
+
+    case 4:
+        return CpuSelfTestRunner<4>(av, assembly, ctx).run(algorithm, full);
+
+    case 5:
+        return CpuSelfTestRunner<5>(av, assembly, ctx).run(algorithm, full);
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+
+// Waits for the full test of the thread's hash function, starts it if the threads were launched without start().
+bool xmrig::CpuSelfTest::wait(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly, bool astrobwtAVX2, size_t ways)
+{
+    const uint64_t id = key(algorithm, av, assembly, astrobwtAVX2);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (results.find(id) == results.end()) {
+        results.insert({ id, SelfTestRunning });
+        lock.unlock();
+
+        onHelper(id, algorithm, av, assembly, ways);
+
+        lock.lock();
+    }
+
+    cv.wait(lock, [id] { return results[id] != SelfTestRunning; });
+
+    return results[id] == SelfTestPassed;
+}
+
+
+// Called after the workers are stopped, they have waited for the tests they need, so the helpers are already done.
+void xmrig::CpuSelfTest::release()
+{
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+
+    helpers.clear();
+}
+
+
+// Starts one helper per hash function which wasn't tested yet and returns immediately.
+void xmrig::CpuSelfTest::start(const std::vector<CpuLaunchData> &threads)
+{
+    release();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto &data : threads) {
+        if (data.algorithm.family() == Algorithm::RANDOM_X) {
+            continue;
+        }
+
+        const uint64_t id = key(data.algorithm, data.av(), data.assembly.id(), data.astrobwtAVX2);
+        if (results.find(id) != results.end()) {
+            continue;
+        }
+
+        results.insert({ id, SelfTestRunning });
+        helpers.emplace_back(onHelper, id, data.algorithm, data.av(), data.assembly.id(), data.intensity);
+    }
+}
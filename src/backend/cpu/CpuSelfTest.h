@@ -0,0 +1,55 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUSELFTEST_H
+#define XMRIG_CPUSELFTEST_H
+
+
+#include "crypto/cn/CnHash.h"
+
+
+#include <vector>
+
+
+struct cryptonight_ctx;
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class CpuLaunchData;
+
+
+// Self-test of the hash functions used by the CPU workers. The full test of each function runs once per process
+// on a helper thread started with the memory preparation, workers then only check their own context.
+class CpuSelfTest
+{
+public:
+    static bool check(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly, cryptonight_ctx **ctx, size_t ways, bool full);
+    static bool wait(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly, bool astrobwtAVX2, size_t ways);
+    static void release();
+    static void start(const std::vector<CpuLaunchData> &threads);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUSELFTEST_H */
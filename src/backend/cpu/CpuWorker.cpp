@@ -22,12 +22,14 @@
 #include <thread>
 
 
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuMemory.h"
+#include "backend/cpu/CpuSelfTest.h"
 #include "backend/cpu/CpuWorker.h"
 #include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
 #include "crypto/cn/CnCtx.h"
-#include "crypto/cn/CryptoNight_test.h"
 #include "crypto/cn/CryptoNight.h"
 #include "crypto/common/Nonce.h"
 #include "crypto/common/VirtualMemory.h"
@@ -39,6 +41,8 @@
 
 #ifdef XMRIG_ALGO_RANDOMX
 #   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/RxMemoryPlan.h"
+#   include "crypto/rx/RxPhaseGate.h"
 #endif
 
 
@@ -56,6 +60,13 @@ namespace xmrig {
 
 static constexpr uint32_t kReserveCount = 32768;
 
+
+// Slower cores of hybrid CPUs reserve smaller nonce blocks, so they don't hold large unused ranges when the job changes.
+static inline uint32_t reserveCount(int64_t affinity)
+{
+    return Cpu::info()->coreKind(affinity) > 0 ? kReserveCount / 4 : kReserveCount;
+}
+
 } // namespace xmrig
 
 
@@ -67,14 +78,34 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_assembly(data.assembly),
     m_astrobwtAVX2(data.astrobwtAVX2),
     m_hwAES(data.hwAES),
+    m_smtPhase(data.smtPhase),
     m_yield(data.yield),
     m_av(data.av()),
     m_astrobwtMaxSize(data.astrobwtMaxSize * 1000),
     m_miner(data.miner),
     m_threads(data.threads),
+    m_partition(data.partition),
+    m_reserve(reserveCount(data.affinity)),
     m_ctx()
 {
-    m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, node());
+    uint64_t allocTime = 0;
+    uint64_t faultTime = 0;
+
+    // The memory is normally reserved and faulted in by the helper of this worker's NUMA node.
+    m_memory = CpuMemory::take(id, allocTime, faultTime);
+
+    if (!m_memory) {
+        uint64_t ts = Chrono::steadyMSecs();
+        m_memory    = new VirtualMemory(CpuMemory::size(m_algorithm) * N, data.hugePages, false, true, node());
+        allocTime   = Chrono::steadyMSecs() - ts;
+
+        ts = Chrono::steadyMSecs();
+        m_memory->prefault();
+        faultTime = Chrono::steadyMSecs() - ts;
+    }
+
+    setStageTime(AllocStage, allocTime);
+    setStageTime(FaultStage, faultTime);
 }
 
 
@@ -94,7 +125,7 @@ xmrig::CpuWorker<N>::~CpuWorker()
 template<size_t N>
 void xmrig::CpuWorker<N>::allocateRandomX_VM()
 {
-    RxDataset *dataset = Rx::dataset(m_job.currentJob(), node());
+    RxDataset *dataset = Rx::dataset(m_job.currentJob(), node(), affinity());
 
     while (dataset == nullptr) {
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
@@ -103,13 +134,24 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
             return;
         }
 
-        dataset = Rx::dataset(m_job.currentJob(), node());
+        dataset = Rx::dataset(m_job.currentJob(), node(), affinity());
+    }
+
+    // Cached seeds live in separate datasets, so a job with another seed may need a new VM.
+    if (m_vm && m_vmDataset != dataset) {
+        RxVm::destroy(m_vm);
+        m_vm = nullptr;
     }
 
     if (!m_vm) {
+        const uint64_t ts = Chrono::steadyMSecs();
+
         // Try to allocate scratchpad from dataset's 1 GB huge pages, if normal huge pages are not available
         uint8_t* scratchpad = m_memory->isHugePages() ? m_memory->scratchpad() : dataset->tryAllocateScrathpad();
-        m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node());
+        m_vm        = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node());
+        m_vmDataset = dataset;
+
+        setStageTime(JitStage, Chrono::steadyMSecs() - ts);
     }
 }
 #endif
@@ -118,68 +160,28 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
 template<size_t N>
 bool xmrig::CpuWorker<N>::selfTest()
 {
-#   ifdef XMRIG_ALGO_RANDOMX
-    if (m_algorithm.family() == Algorithm::RANDOM_X) {
-        return N == 1;
-    }
-#   endif
+    const uint64_t ts = Chrono::steadyMSecs();
+    const bool rc     = runSelfTest();
 
-    allocateCnCtx();
-
-    if (m_algorithm.family() == Algorithm::CN) {
-        const bool rc = verify(Algorithm::CN_0,      test_output_v0)   &&
-                        verify(Algorithm::CN_1,      test_output_v1)   &&
-                        verify(Algorithm::CN_2,      test_output_v2)   &&
-                        verify(Algorithm::CN_FAST,   test_output_msr)  &&
-                        verify(Algorithm::CN_XAO,    test_output_xao)  &&
-                        verify(Algorithm::CN_RTO,    test_output_rto)  &&
-                        verify(Algorithm::CN_HALF,   test_output_half) &&
-                        verify2(Algorithm::CN_R,     test_output_r)    &&
-                        verify(Algorithm::CN_RWZ,    test_output_rwz)  &&
-                        verify(Algorithm::CN_ZLS,    test_output_zls)  &&
-                        verify(Algorithm::CN_CCX,    test_output_ccx)  &&
-                        verify(Algorithm::CN_DOUBLE, test_output_double);
-
-        return rc;
-    }
+    setStageTime(SelfTestStage, Chrono::steadyMSecs() - ts);
 
-#   ifdef XMRIG_ALGO_CN_LITE
-    if (m_algorithm.family() == Algorithm::CN_LITE) {
-        return verify(Algorithm::CN_LITE_0,    test_output_v0_lite) &&
-               verify(Algorithm::CN_LITE_1,    test_output_v1_lite);
-    }
-#   endif
-
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    if (m_algorithm.family() == Algorithm::CN_HEAVY) {
-        return verify(Algorithm::CN_HEAVY_0,    test_output_v0_heavy)  &&
-               verify(Algorithm::CN_HEAVY_XHV,  test_output_xhv_heavy) &&
-               verify(Algorithm::CN_HEAVY_TUBE, test_output_tube_heavy);
-    }
-#   endif
+    return rc;
+}
 
-#   ifdef XMRIG_ALGO_CN_PICO
-    if (m_algorithm.family() == Algorithm::CN_PICO) {
-        return verify(Algorithm::CN_PICO_0, test_output_pico_trtl) &&
-               verify(Algorithm::CN_PICO_TLO, test_output_pico_tlo);
-    }
-#   endif
 
-#   ifdef XMRIG_ALGO_ARGON2
-    if (m_algorithm.family() == Algorithm::ARGON2) {
-        return verify(Algorithm::AR2_CHUKWA, argon2_chukwa_test_out) &&
-               verify(Algorithm::AR2_CHUKWA_V2, argon2_chukwa_v2_test_out) &&
-               verify(Algorithm::AR2_WRKZ, argon2_wrkz_test_out);
+template<size_t N>
+bool xmrig::CpuWorker<N>::runSelfTest()
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (m_algorithm.family() == Algorithm::RANDOM_X) {
+        return N == 1;
     }
 #   endif
 
-#   ifdef XMRIG_ALGO_ASTROBWT
-    if (m_algorithm.family() == Algorithm::ASTROBWT) {
-        return verify(Algorithm::ASTROBWT_DERO, astrobwt_dero_test_out);
-    }
-#   endif
+    allocateCnCtx();
 
-    return false;
+    // The full test runs on a helper thread started with the memory preparation, this one only checks the own context.
+    return CpuSelfTest::wait(m_algorithm, m_av, m_assembly, m_astrobwtAVX2, N) && CpuSelfTest::check(m_algorithm, m_av, m_assembly, m_ctx, N, false);
 }
 
 
@@ -191,15 +193,39 @@ void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::resume()
+{
+    Worker::resume();
+
+    // Nonce sequences start over after a stop, so the job from the previous run could look current.
+    m_job.reset();
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    // A light mode VM is compiled for the cache it was created with, the seed may have changed while the worker was parked.
+    RxVm::destroy(m_vm);
+    m_vm        = nullptr;
+    m_vmDataset = nullptr;
+#   endif
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
+#   ifdef XMRIG_ALGO_RANDOMX
+    randomx_set_phase_gate((m_smtPhase && m_algorithm == Algorithm::RX_XLA) ? RxPhaseGate::get(affinity()) : nullptr);
+    RxMemoryPlan::bind(m_algorithm, m_memory->scratchpad());
+#   endif
+
     while (Nonce::sequence(Nonce::CPU) > 0) {
-        if (Nonce::isPaused()) {
+        // Parked workers sleep like paused ones, the pressure governor parks the workers with the highest ids first.
+        // Workers of a weighted pool partition also sleep while that pool has no job.
+        if (isIdle()) {
             do {
                 std::this_thread::sleep_for(std::chrono::milliseconds(200));
             }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
+            while (isIdle() && Nonce::sequence(Nonce::CPU) > 0);
 
             if (Nonce::sequence(Nonce::CPU) == 0) {
                 break;
@@ -213,7 +239,7 @@ void xmrig::CpuWorker<N>::start()
         alignas(16) uint64_t tempHash[8] = {};
 #       endif
 
-        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
+        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence()) && !Nonce::isParked(id())) {
             const Job &job = m_job.currentJob();
 
             if (job.algorithm().l3() != m_algorithm.l3()) {
@@ -299,6 +325,10 @@ void xmrig::CpuWorker<N>::start()
 
         consumeJob();
     }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    RxMemoryPlan::unbind();
+#   endif
 }
 
 
@@ -306,9 +336,9 @@ template<size_t N>
 bool xmrig::CpuWorker<N>::nextRound()
 {
 #   ifdef XMRIG_FEATURE_BENCHMARK
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    const uint32_t count = m_benchSize ? 1U : m_reserve;
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = m_reserve;
 #   endif
 
     if (!m_job.nextRound(count, 1)) {
@@ -322,69 +352,12 @@ bool xmrig::CpuWorker<N>::nextRound()
 
 
 template<size_t N>
-bool xmrig::CpuWorker<N>::verify(const Algorithm &algorithm, const uint8_t *referenceValue)
+bool xmrig::CpuWorker<N>::isIdle() const
 {
-    cn_hash_fun func = fn(algorithm);
-    if (!func) {
-        return false;
-    }
-
-    func(test_input, 76, m_hash, m_ctx, 0);
-    return memcmp(m_hash, referenceValue, sizeof m_hash) == 0;
+    return Nonce::isPaused() || Nonce::isParked(id()) || !m_miner->job(m_partition).isValid();
 }
 
 
-template<size_t N>
-bool xmrig::CpuWorker<N>::verify2(const Algorithm &algorithm, const uint8_t *referenceValue)
-{
-    cn_hash_fun func = fn(algorithm);
-    if (!func) {
-        return false;
-    }
-
-    for (size_t i = 0; i < (sizeof(cn_r_test_input) / sizeof(cn_r_test_input[0])); ++i) {
-        const size_t size = cn_r_test_input[i].size;
-        for (size_t k = 0; k < N; ++k) {
-            memcpy(m_job.blob() + (k * size), cn_r_test_input[i].data, size);
-        }
-
-        func(m_job.blob(), size, m_hash, m_ctx, cn_r_test_input[i].height);
-
-        for (size_t k = 0; k < N; ++k) {
-            if (memcmp(m_hash + k * 32, referenceValue + i * 32, sizeof m_hash / N) != 0) {
-                return false;
-            }
-        }
-    }
-
-    return true;
-}
-
-
-namespace xmrig {
-
-template<>
-bool CpuWorker<1>::verify2(const Algorithm &algorithm, const uint8_t *referenceValue)
-{
-    cn_hash_fun func = fn(algorithm);
-    if (!func) {
-        return false;
-    }
-
-    for (size_t i = 0; i < (sizeof(cn_r_test_input) / sizeof(cn_r_test_input[0])); ++i) {
-        func(cn_r_test_input[i].data, cn_r_test_input[i].size, m_hash, m_ctx, cn_r_test_input[i].height);
-
-        if (memcmp(m_hash, referenceValue + i * 32, sizeof m_hash) != 0) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
-} // namespace xmrig
-
-
 template<size_t N>
 void xmrig::CpuWorker<N>::allocateCnCtx()
 {
@@ -401,13 +374,16 @@ void xmrig::CpuWorker<N>::consumeJob()
         return;
     }
 
-    auto job = m_miner->job();
+    auto job = m_miner->job(m_partition);
+    if (!job.isValid()) {
+        return;
+    }
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     m_benchSize          = job.benchSize();
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    const uint32_t count = m_benchSize ? 1U : m_reserve;
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = m_reserve;
 #   endif
 
     m_job.add(job, count, Nonce::CPU);
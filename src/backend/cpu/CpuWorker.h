@@ -35,6 +35,7 @@ class randomx_vm;
 namespace xmrig {
 
 
+class RxDataset;
 class RxVm;
 
 
@@ -50,6 +51,7 @@ public:
 protected:
     bool selfTest() override;
     void hashrateData(uint64_t &hashCount, uint64_t &timeStamp, uint64_t &rawHashes) const override;
+    void resume() override;
     void start() override;
 
     inline const VirtualMemory *memory() const override     { return m_memory; }
@@ -63,9 +65,9 @@ private:
     void allocateRandomX_VM();
 #   endif
 
+    bool isIdle() const;
     bool nextRound();
-    bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
-    bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
+    bool runSelfTest();
     void allocateCnCtx();
     void consumeJob();
 
@@ -74,17 +76,21 @@ private:
     const Assembly m_assembly;
     const bool m_astrobwtAVX2;
     const bool m_hwAES;
+    const bool m_smtPhase;
     const bool m_yield;
     const CnHash::AlgoVariant m_av;
     const int m_astrobwtMaxSize;
     const Miner *m_miner;
     const size_t m_threads;
+    const uint32_t m_partition;
+    const uint32_t m_reserve;
     cryptonight_ctx *m_ctx[N];
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
 #   ifdef XMRIG_ALGO_RANDOMX
     randomx_vm *m_vm        = nullptr;
+    RxDataset *m_vmDataset  = nullptr;
 #   endif
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -93,10 +99,6 @@ private:
 };
 
 
-template<>
-bool CpuWorker<1>::verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
-
-
 extern template class CpuWorker<1>;
 extern template class CpuWorker<2>;
 extern template class CpuWorker<3>;
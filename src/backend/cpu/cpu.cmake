@@ -4,6 +4,8 @@ set(HEADERS_BACKEND_CPU
     src/backend/cpu/CpuConfig_gen.h
     src/backend/cpu/CpuConfig.h
     src/backend/cpu/CpuLaunchData.cpp
+    src/backend/cpu/CpuMemory.h
+    src/backend/cpu/CpuSelfTest.h
     src/backend/cpu/CpuThread.h
     src/backend/cpu/CpuThreads.h
     src/backend/cpu/CpuWorker.h
@@ -16,6 +18,8 @@ set(SOURCES_BACKEND_CPU
     src/backend/cpu/CpuBackend.cpp
     src/backend/cpu/CpuConfig.cpp
     src/backend/cpu/CpuLaunchData.h
+    src/backend/cpu/CpuMemory.cpp
+    src/backend/cpu/CpuSelfTest.cpp
     src/backend/cpu/CpuThread.cpp
     src/backend/cpu/CpuThreads.cpp
     src/backend/cpu/CpuWorker.cpp
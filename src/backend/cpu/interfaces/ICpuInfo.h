@@ -45,7 +45,8 @@ public:
         ARCH_ZEN,
         ARCH_ZEN_PLUS,
         ARCH_ZEN2,
-        ARCH_ZEN3
+        ARCH_ZEN3,
+        ARCH_ZEN4
     };
 
     enum MsrMod : uint32_t {
@@ -105,11 +106,14 @@ public:
     virtual MsrMod msrMod() const                                                   = 0;
     virtual rapidjson::Value toJSON(rapidjson::Document &doc) const                 = 0;
     virtual size_t cores() const                                                    = 0;
+    virtual size_t coreKinds() const                                                = 0;
     virtual size_t L2() const                                                       = 0;
     virtual size_t L3() const                                                       = 0;
     virtual size_t nodes() const                                                    = 0;
     virtual size_t packages() const                                                 = 0;
     virtual size_t threads() const                                                  = 0;
+    virtual uint32_t coreKind(int64_t affinity) const                               = 0;
+    virtual uint32_t node(int64_t affinity) const                                   = 0;
     virtual Vendor vendor() const                                                   = 0;
 };
 
@@ -243,7 +243,12 @@ xmrig::BasicCpuInfo::BasicCpuInfo() :
                     break;
 
                 case 0x19:
-                    m_arch = ARCH_ZEN3;
+                    if ((m_model >= 0x10 && m_model <= 0x1f) || (m_model >= 0x60 && m_model <= 0x7f) || (m_model >= 0xa0 && m_model <= 0xaf)) {
+                        m_arch = ARCH_ZEN4;
+                    }
+                    else {
+                        m_arch = ARCH_ZEN3;
+                    }
                     m_msrMod = MSR_MOD_RYZEN_19H;
                     break;
 
@@ -395,6 +400,7 @@ rapidjson::Value xmrig::BasicCpuInfo::toJSON(rapidjson::Document &doc) const
     out.AddMember("l3",         static_cast<uint64_t>(L3()), allocator);
     out.AddMember("cores",      static_cast<uint64_t>(cores()), allocator);
     out.AddMember("threads",    static_cast<uint64_t>(threads()), allocator);
+    out.AddMember("core_kinds", static_cast<uint64_t>(coreKinds()), allocator);
     out.AddMember("packages",   static_cast<uint64_t>(packages()), allocator);
     out.AddMember("nodes",      static_cast<uint64_t>(nodes()), allocator);
     out.AddMember("backend",    StringRef(backend()), allocator);
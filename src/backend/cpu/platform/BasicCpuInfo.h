@@ -56,11 +56,14 @@ protected:
     inline const std::vector<int32_t> &units() const override   { return m_units; }
     inline MsrMod msrMod() const override                       { return m_msrMod; }
     inline size_t cores() const override                        { return 0; }
+    inline size_t coreKinds() const override                    { return 1; }
     inline size_t L2() const override                           { return 0; }
     inline size_t L3() const override                           { return 0; }
     inline size_t nodes() const override                        { return 0; }
     inline size_t packages() const override                     { return 1; }
     inline size_t threads() const override                      { return m_threads; }
+    inline uint32_t coreKind(int64_t) const override            { return 0; }
+    inline uint32_t node(int64_t) const override                { return 0; }
     inline Vendor vendor() const override                       { return m_vendor; }
 
 protected:
@@ -18,14 +18,13 @@
  */
 
 
-#ifdef XMRIG_HWLOC_DEBUG
-#   include <uv.h>
-#endif
-
-
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <hwloc.h>
+#include <string>
+#include <uv.h>
 
 
 #if HWLOC_API_VERSION < 0x00010b00
@@ -36,6 +35,8 @@
 
 #include "backend/cpu/platform/HwlocCpuInfo.h"
 #include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/String.h"
 
 
 namespace xmrig {
@@ -44,6 +45,11 @@ namespace xmrig {
 uint32_t HwlocCpuInfo::m_features = 0;
 
 
+static bool cacheRefresh    = false;
+static const char *kCacheId = "XlarigCacheId";
+static String cachePath;
+
+
 static inline bool isCacheObject(hwloc_obj_t obj)
 {
 #   if HWLOC_API_VERSION >= 0x20000
@@ -121,13 +127,113 @@ static inline bool isCacheExclusive(hwloc_obj_t obj)
 #endif
 
 
+static std::string readLine(const char *path)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    if (file.is_open()) {
+        std::getline(file, line);
+    }
+
+    return line;
+}
+
+
+// Machine identity stored in the cached topology, the cache is used only on the same board, CPU and boot.
+static std::string cacheId(const char *brand)
+{
+    std::string id = brand;
+
+#   ifdef XMRIG_OS_LINUX
+    for (const char *path : { "/sys/class/dmi/id/board_serial", "/sys/class/dmi/id/product_uuid", "/proc/sys/kernel/random/boot_id" }) {
+        id += '|';
+        id += readLine(path);
+    }
+#   endif
+
+#   if UV_VERSION_HEX >= 0x011200
+    char hostname[256] = { 0 };
+    size_t size        = sizeof(hostname);
+
+    if (uv_os_gethostname(hostname, &size) == 0) {
+        id += '|';
+        id += hostname;
+    }
+#   endif
+
+    return id;
+}
+
+
+// Everything the miner takes from the topology, a cached topology with another fingerprint is outdated.
+static std::string fingerprint(hwloc_topology_t topology)
+{
+    size_t cache[5] = { 0 };
+    findCache(hwloc_get_root_obj(topology), 2, 3, [&cache](hwloc_obj_t found) { cache[found->attr->cache.depth] += found->attr->cache.size; });
+
+    int kinds = 1;
+#   if HWLOC_API_VERSION >= 0x00020400
+    kinds = std::max(hwloc_cpukinds_get_nr(topology, 0), 1);
+#   endif
+
+    char buf[128] = { 0 };
+    snprintf(buf, sizeof(buf), "%zu/%zu/%zu/%d/%zu/%zu/%d",
+             countByType(topology, HWLOC_OBJ_PU),
+             countByType(topology, HWLOC_OBJ_CORE),
+             countByType(topology, HWLOC_OBJ_PACKAGE),
+             hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(topology)),
+             cache[2],
+             cache[3],
+             kinds
+             );
+
+    return buf;
+}
+
+
+static bool exportCache(hwloc_topology_t topology, const std::string &id)
+{
+    if (cachePath.isNull()) {
+        return false;
+    }
+
+    hwloc_obj_t root        = hwloc_get_root_obj(topology);
+    const char *current     = hwloc_obj_get_info_by_name(root, kCacheId);
+
+    if (current == nullptr || id != current) {
+        hwloc_obj_add_info(root, kCacheId, id.c_str());
+    }
+
+    // Written to a temporary file and renamed, so instances started at the same time never read a partial file.
+    const std::string tmp = std::string(cachePath.data()) + ".tmp";
+
+#   if HWLOC_API_VERSION >= 0x20000
+    if (hwloc_topology_export_xml(topology, tmp.c_str(), 0) == -1) {
+#   else
+    if (hwloc_topology_export_xml(topology, tmp.c_str()) == -1) {
+#   endif
+        return false;
+    }
+
+    return std::rename(tmp.c_str(), cachePath) == 0;
+}
+
+
 } // namespace xmrig
 
 
 xmrig::HwlocCpuInfo::HwlocCpuInfo()
 {
     hwloc_topology_init(&m_topology);
-    hwloc_topology_load(m_topology);
+
+    const std::string id = cachePath.isNull() ? std::string() : cacheId(m_brand);
+    const bool cached    = loadCache(id);
+
+    if (!cached) {
+        hwloc_topology_load(m_topology);
+        exportCache(m_topology, id);
+    }
 
 #   ifdef XMRIG_HWLOC_DEBUG
 #   if defined(UV_VERSION_HEX) && UV_VERSION_HEX >= 0x010c00
@@ -170,6 +276,7 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
     findCache(root, 2, 3, [this](hwloc_obj_t found) { this->m_cache[found->attr->cache.depth] += found->attr->cache.size; });
 
     setThreads(countByType(m_topology, HWLOC_OBJ_PU));
+    setCoreKinds();
 
     m_cores     = countByType(m_topology, HWLOC_OBJ_CORE);
     m_nodes     = std::max(hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(m_topology)), 1);
@@ -193,15 +300,69 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
         m_cache[2] = 16777216U;
     }
 #   endif
+
+    if (cached) {
+        m_revalidate = std::thread(&HwlocCpuInfo::revalidate, id, fingerprint(m_topology));
+    }
 }
 
 
 xmrig::HwlocCpuInfo::~HwlocCpuInfo()
 {
+    if (m_revalidate.joinable()) {
+        m_revalidate.join();
+    }
+
     hwloc_topology_destroy(m_topology);
 }
 
 
+void xmrig::HwlocCpuInfo::setCache(const char *path, bool refresh)
+{
+    cachePath    = path;
+    cacheRefresh = refresh;
+}
+
+
+bool xmrig::HwlocCpuInfo::loadCache(const std::string &id)
+{
+    if (cachePath.isNull() || cacheRefresh || getenv("HWLOC_XMLFILE") != nullptr) {
+        return false;
+    }
+
+    // Binding uses the native OS functions, the cache describes this system.
+    if (hwloc_topology_set_xml(m_topology, cachePath) == 0 &&
+        hwloc_topology_set_flags(m_topology, HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM) == 0 &&
+        hwloc_topology_load(m_topology) == 0) {
+        const char *value = hwloc_obj_get_info_by_name(hwloc_get_root_obj(m_topology), kCacheId);
+        if (value && id == value) {
+            return true;
+        }
+    }
+
+    hwloc_topology_destroy(m_topology);
+    hwloc_topology_init(&m_topology);
+
+    return false;
+}
+
+
+void xmrig::HwlocCpuInfo::revalidate(std::string id, std::string expected)
+{
+    hwloc_topology_t topology;
+    hwloc_topology_init(&topology);
+    hwloc_topology_load(topology);
+
+    if (fingerprint(topology) != expected) {
+        exportCache(topology, id);
+
+        LOG_WARN("%s " YELLOW("hwloc topology cache ") YELLOW_BOLD("\"%s\"") YELLOW(" was outdated and has been refreshed, restart to use the new topology"), Tags::cpu(), cachePath.data());
+    }
+
+    hwloc_topology_destroy(topology);
+}
+
+
 bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 {
     if (!hwloc_topology_get_support(m_topology)->membind->set_thisthread_membind) {
@@ -216,6 +377,31 @@ bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 }
 
 
+uint32_t xmrig::HwlocCpuInfo::coreKind(int64_t affinity) const
+{
+    if (affinity < 0 || static_cast<size_t>(affinity) >= m_kinds.size()) {
+        return 0;
+    }
+
+    return m_kinds[affinity];
+}
+
+
+uint32_t xmrig::HwlocCpuInfo::node(int64_t affinity) const
+{
+    if (affinity < 0 || m_nodes < 2) {
+        return 0;
+    }
+
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(m_topology, static_cast<unsigned>(affinity));
+    if (pu == nullptr || hwloc_bitmap_iszero(pu->nodeset)) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(hwloc_bitmap_first(pu->nodeset));
+}
+
+
 xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit) const
 {
 #   ifdef XMRIG_ALGO_ASTROBWT
@@ -354,11 +540,18 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
         cacheHashes = std::min(cacheHashes, limit);
     }
 
+    // On hybrid CPUs performance cores are filled first, efficiency cores get what is left and never use multi-hash intensity.
+    if (m_coreKinds > 1) {
+        std::stable_sort(cores.begin(), cores.end(), [this](hwloc_obj_t a, hwloc_obj_t b) { return coreKind(a) < coreKind(b); });
+    }
+
+    auto kindIntensity = [this, intensity](hwloc_obj_t core) { return coreKind(core) > 0 ? std::min<uint32_t>(intensity, 1) : intensity; };
+
     if (cacheHashes >= PUs) {
         for (hwloc_obj_t core : cores) {
             const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
             for (hwloc_obj_t pu : units) {
-                threads.add(pu->os_index, intensity);
+                threads.add(pu->os_index, kindIntensity(core));
             }
         }
 
@@ -383,7 +576,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
             PUs--;
 
             allocated_pu = true;
-            threads_data.emplace_back(units[pu_id]->os_index, intensity);
+            threads_data.emplace_back(units[pu_id]->os_index, kindIntensity(core));
 
             if (cacheHashes == 0) {
                 break;
@@ -413,6 +606,51 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 }
 
 
+uint32_t xmrig::HwlocCpuInfo::coreKind(hwloc_obj_t core) const
+{
+    return m_coreKinds > 1 ? coreKind(hwloc_bitmap_first(core->cpuset)) : 0;
+}
+
+
+void xmrig::HwlocCpuInfo::setCoreKinds()
+{
+#   if HWLOC_API_VERSION >= 0x00020400
+    const int count = hwloc_cpukinds_get_nr(m_topology, 0);
+    if (count < 2) {
+        return;
+    }
+
+    // hwloc sorts kinds by increasing efficiency (performance), kind 0 here is the fastest one.
+    hwloc_bitmap_t cpuset = hwloc_bitmap_alloc();
+    m_kinds.assign(static_cast<size_t>(hwloc_bitmap_last(hwloc_topology_get_complete_cpuset(m_topology))) + 1, 0);
+
+    for (int i = 0; i < count; ++i) {
+        int efficiency = -1;
+        if (hwloc_cpukinds_get_info(m_topology, static_cast<unsigned>(i), cpuset, &efficiency, nullptr, nullptr, 0) != 0 || efficiency < 0) {
+            m_kinds.clear();
+
+            break;
+        }
+
+        const auto kind = static_cast<uint8_t>(count - 1 - i);
+        int pu          = -1;
+
+        while ((pu = hwloc_bitmap_next(cpuset, pu)) != -1) {
+            if (static_cast<size_t>(pu) < m_kinds.size()) {
+                m_kinds[pu] = kind;
+            }
+        }
+    }
+
+    hwloc_bitmap_free(cpuset);
+
+    if (!m_kinds.empty()) {
+        m_coreKinds = static_cast<size_t>(count);
+    }
+#   endif
+}
+
+
 void xmrig::HwlocCpuInfo::setThreads(size_t threads)
 {
     if (!threads) {
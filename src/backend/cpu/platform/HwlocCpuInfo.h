@@ -24,6 +24,10 @@
 #include "base/tools/Object.h"
 
 
+#include <string>
+#include <thread>
+
+
 using hwloc_const_bitmap_t  = const struct hwloc_bitmap_s *;
 using hwloc_obj_t           = struct hwloc_obj *;
 using hwloc_topology_t      = struct hwloc_topology *;
@@ -48,6 +52,8 @@ public:
 
     static inline bool hasFeature(Feature feature)              { return m_features & feature; }
 
+    static void setCache(const char *path, bool refresh);
+
     inline const std::vector<uint32_t> &nodeset() const         { return m_nodeset; }
     inline hwloc_topology_t topology() const                    { return m_topology; }
 
@@ -58,14 +64,23 @@ protected:
 
     inline const char *backend() const override     { return m_backend; }
     inline size_t cores() const override            { return m_cores; }
+    inline size_t coreKinds() const override        { return m_coreKinds; }
     inline size_t L2() const override               { return m_cache[2]; }
     inline size_t L3() const override               { return m_cache[3]; }
     inline size_t nodes() const override            { return m_nodes; }
     inline size_t packages() const override         { return m_packages; }
 
+    uint32_t coreKind(int64_t affinity) const override;
+    uint32_t node(int64_t affinity) const override;
+
 private:
+    static void revalidate(std::string id, std::string expected);
+
+    bool loadCache(const std::string &id);
     CpuThreads allThreads(const Algorithm &algorithm, uint32_t limit) const;
     void processTopLevelCache(hwloc_obj_t obj, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const;
+    uint32_t coreKind(hwloc_obj_t core) const;
+    void setCoreKinds();
     void setThreads(size_t threads);
 
     static uint32_t m_features;
@@ -73,10 +88,13 @@ private:
     char m_backend[20]          = { 0 };
     hwloc_topology_t m_topology = nullptr;
     size_t m_cache[5]           = { 0 };
+    size_t m_coreKinds          = 1;
     size_t m_cores              = 0;
     size_t m_nodes              = 0;
     size_t m_packages           = 0;
+    std::thread m_revalidate;
     std::vector<uint32_t> m_nodeset;
+    std::vector<uint8_t> m_kinds;
 };
 
 
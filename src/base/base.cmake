@@ -19,6 +19,7 @@ set(HEADERS_BASE
     src/base/io/Signals.h
     src/base/io/Watcher.h
     src/base/kernel/Base.h
+    src/base/kernel/Cgroup.h
     src/base/kernel/config/BaseConfig.h
     src/base/kernel/config/BaseTransform.h
     src/base/kernel/config/Title.h
@@ -53,10 +54,13 @@ set(HEADERS_BASE
     src/base/net/stratum/Pool.h
     src/base/net/stratum/Pools.h
     src/base/net/stratum/ProxyUrl.h
+    src/base/net/stratum/replay/ReplayClient.h
+    src/base/net/stratum/replay/ReplayConfig.h
     src/base/net/stratum/Socks5.h
     src/base/net/stratum/strategies/FailoverStrategy.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
     src/base/net/stratum/strategies/StrategyProxy.h
+    src/base/net/stratum/strategies/WeightedStrategy.h
     src/base/net/stratum/SubmitResult.h
     src/base/net/stratum/Url.h
     src/base/net/tools/LineReader.h
@@ -92,6 +96,7 @@ set(SOURCES_BASE
     src/base/io/Signals.cpp
     src/base/io/Watcher.cpp
     src/base/kernel/Base.cpp
+    src/base/kernel/Cgroup.cpp
     src/base/kernel/config/BaseConfig.cpp
     src/base/kernel/config/BaseTransform.cpp
     src/base/kernel/config/Title.cpp
@@ -108,9 +113,12 @@ set(SOURCES_BASE
     src/base/net/stratum/Pool.cpp
     src/base/net/stratum/Pools.cpp
     src/base/net/stratum/ProxyUrl.cpp
+    src/base/net/stratum/replay/ReplayClient.cpp
+    src/base/net/stratum/replay/ReplayConfig.cpp
     src/base/net/stratum/Socks5.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
+    src/base/net/stratum/strategies/WeightedStrategy.cpp
     src/base/net/stratum/Url.cpp
     src/base/net/tools/LineReader.cpp
     src/base/net/tools/NetBuffer.cpp
@@ -25,6 +25,9 @@
 
 #include <cassert>
 #include <memory>
+#include <string>
+#include <uv.h>
+#include <vector>
 
 
 #include "base/kernel/Base.h"
@@ -39,6 +42,7 @@
 #include "base/kernel/Platform.h"
 #include "base/kernel/Process.h"
 #include "base/net/tools/NetBuffer.h"
+#include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/config/ConfigTransform.h"
 #include "version.h"
@@ -70,6 +74,33 @@ static const char *kConfigPathV2 = "/2/config";
 namespace xmrig {
 
 
+class BasePrivate;
+
+
+// Everything but applying the new configuration runs on the libuv thread pool.
+struct ReloadBaton
+{
+    inline ReloadBaton(BasePrivate *d, const Config *previous, const String &fileName) :
+        d(d),
+        previous(previous),
+        fileName(fileName)
+    {
+        req.data = this;
+    }
+
+    BasePrivate *d;
+    bool ok                 = false;
+    Config *config          = nullptr;
+    const Config *previous;
+    const String fileName;
+    std::vector<std::string> changed;
+    uint64_t diffTime       = 0;
+    uint64_t parseTime      = 0;
+    uint64_t readTime       = 0;
+    uv_work_t req{};
+};
+
+
 class BasePrivate
 {
 public:
@@ -93,6 +124,10 @@ public:
         delete config;
         delete watcher;
 
+        for (Config *retiredConfig : retired) {
+            delete retiredConfig;
+        }
+
         NetBuffer::destroy();
     }
 
@@ -101,30 +136,169 @@ public:
     {
         config = std::unique_ptr<Config>(new Config());
 
-        return config->read(chain, chain.fileName());
+        if (!config->read(chain, chain.fileName())) {
+            return false;
+        }
+
+        config->applyLog();
+
+        return true;
     }
 
 
     inline void replace(Config *newConfig)
     {
         Config *previousConfig = config;
+
+        newConfig->applyLog();
         config = newConfig;
 
         for (IBaseListener *listener : listeners) {
             listener->onConfigChanged(config, previousConfig);
         }
 
-        delete previousConfig;
+        // A reload in progress compares against the previous configuration, keep it until the reload is done.
+        if (reloading) {
+            retired.push_back(previousConfig);
+        }
+        else {
+            delete previousConfig;
+        }
+    }
+
+
+    inline void reload(const String &fileName)
+    {
+        if (reloading) {
+            pendingReload = true;
+
+            return;
+        }
+
+        reloading     = true;
+        pendingReload = false;
+
+        auto baton = new ReloadBaton(this, config, fileName);
+
+        uv_queue_work(uv_default_loop(), &baton->req, BasePrivate::onReload, BasePrivate::onReloaded);
     }
 
 
     Api *api            = nullptr;
+    bool pendingReload  = false;
+    bool reloading      = false;
     Config *config      = nullptr;
+    std::vector<Config *> retired;
     std::vector<IBaseListener *> listeners;
     Watcher *watcher    = nullptr;
 
 
 private:
+    static void diff(const Config &previous, const Config &config, std::vector<std::string> &changed)
+    {
+        rapidjson::Document a;
+        rapidjson::Document b;
+        previous.getJSON(a);
+        config.getJSON(b);
+
+        for (const auto &member : b.GetObject()) {
+            const auto it = a.FindMember(member.name);
+            if (it == a.MemberEnd() || it->value != member.value) {
+                changed.emplace_back(member.name.GetString());
+            }
+        }
+
+        for (const auto &member : a.GetObject()) {
+            if (!b.HasMember(member.name)) {
+                changed.emplace_back(member.name.GetString());
+            }
+        }
+    }
+
+
+    static void onReload(uv_work_t *req)
+    {
+        auto baton    = static_cast<ReloadBaton *>(req->data);
+        uint64_t ts   = Chrono::steadyMSecs();
+
+        JsonChain chain;
+        if (!chain.addFile(baton->fileName)) {
+            return;
+        }
+
+        baton->parseTime = Chrono::steadyMSecs() - ts;
+        ts               = Chrono::steadyMSecs();
+        baton->config    = new Config();
+        baton->ok        = baton->config->read(chain, chain.fileName());
+        baton->readTime  = Chrono::steadyMSecs() - ts;
+
+        if (baton->ok && baton->previous) {
+            ts = Chrono::steadyMSecs();
+            diff(*baton->previous, *baton->config, baton->changed);
+            baton->diffTime = Chrono::steadyMSecs() - ts;
+        }
+    }
+
+
+    static void onReloaded(uv_work_t *req, int status)
+    {
+        auto baton = static_cast<ReloadBaton *>(req->data);
+        auto d     = baton->d;
+
+        d->reloading = false;
+
+        for (Config *config : d->retired) {
+            delete config;
+        }
+
+        d->retired.clear();
+
+        // The configuration was replaced by the API during the reload, the diff is stale.
+        if (baton->previous != d->config) {
+            baton->changed.clear();
+            baton->changed.emplace_back("*");
+        }
+
+        if (status != 0 || !baton->ok) {
+            if (status == 0) {
+                LOG_ERR("%s " RED("reloading failed"), Tags::config());
+            }
+
+            delete baton->config;
+            delete baton;
+
+            return;
+        }
+
+        if (baton->changed.empty()) {
+            LOG_INFO("%s " WHITE_BOLD("no changes") BLACK_BOLD(" (parse %" PRIu64 " ms, read %" PRIu64 " ms, diff %" PRIu64 " ms)"),
+                     Tags::config(), baton->parseTime, baton->readTime, baton->diffTime);
+
+            delete baton->config;
+        }
+        else {
+            std::string changed;
+            for (const auto &key : baton->changed) {
+                changed += (changed.empty() ? "" : ", ") + key;
+            }
+
+            // The diff only decides whether anything changed, listeners still get the whole config and compare their own sections.
+            const uint64_t ts = Chrono::steadyMSecs();
+            d->replace(baton->config);
+
+            LOG_INFO("%s " GREEN_BOLD("reloaded") ", changed " WHITE_BOLD("%s") BLACK_BOLD(" (parse %" PRIu64 " ms, read %" PRIu64 " ms, diff %" PRIu64 " ms, apply %" PRIu64 " ms)"),
+                     Tags::config(), changed.c_str(), baton->parseTime, baton->readTime, baton->diffTime, Chrono::steadyMSecs() - ts);
+        }
+
+        const String fileName = baton->fileName;
+        delete baton;
+
+        if (d->pendingReload) {
+            d->reload(fileName);
+        }
+    }
+
+
     inline Config *load(Process *process)
     {
         JsonChain chain;
@@ -304,19 +478,7 @@ void xmrig::Base::onFileChanged(const String &fileName)
 {
     LOG_WARN("%s " YELLOW("\"%s\" was changed, reloading configuration"), Tags::config(), fileName.data());
 
-    JsonChain chain;
-    chain.addFile(fileName);
-
-    auto config = new Config();
-
-    if (!config->read(chain, chain.fileName())) {
-        LOG_ERR("%s " RED("reloading failed"), Tags::config());
-
-        delete config;
-        return;
-    }
-
-    d_ptr->replace(config);
+    d_ptr->reload(fileName);
 }
 
 
@@ -0,0 +1,388 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/kernel/Cgroup.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <uv.h>
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <sys/stat.h>
+#endif
+
+
+namespace xmrig {
+
+
+const char *Cgroup::kRoot   = "/sys/fs/cgroup";
+const char *Cgroup::kSelf   = "/proc/self/cgroup";
+
+
+#ifdef XMRIG_OS_LINUX
+// cgroup v1 reports "no limit" as a page aligned LONG_MAX.
+constexpr uint64_t kV1Unlimited = 1ULL << 62;
+
+
+static bool isDir(const std::string &path)
+{
+    struct stat st{};
+
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+
+static bool readLine(const std::string &path, std::string &line)
+{
+    std::ifstream file(path);
+
+    return file.is_open() && std::getline(file, line) && !line.empty();
+}
+
+
+// Returns kUnlimited for "max", a missing file or a v1 value that means no limit.
+static uint64_t readLimit(const std::string &path)
+{
+    std::string line;
+    if (!readLine(path, line) || line.compare(0, 3, "max") == 0 || line[0] == '-') {
+        return Cgroup::kUnlimited;
+    }
+
+    const uint64_t value = strtoull(line.c_str(), nullptr, 10);
+
+    return value >= kV1Unlimited ? Cgroup::kUnlimited : value;
+}
+
+
+static std::vector<int32_t> parseList(const std::string &list)
+{
+    std::vector<int32_t> out;
+    const char *p = list.c_str();
+
+    while (*p) {
+        char *end     = nullptr;
+        const long lo = strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+
+        long hi = lo;
+        if (*end == '-') {
+            p  = end + 1;
+            hi = strtol(p, &end, 10);
+        }
+
+        for (long i = lo; i <= hi && i >= 0; ++i) {
+            out.emplace_back(static_cast<int32_t>(i));
+        }
+
+        p = *end == ',' ? end + 1 : end;
+        if (end == p) {
+            break;
+        }
+    }
+
+    return out;
+}
+
+
+static const char *hugetlbName(size_t hugePageSize)
+{
+    switch (hugePageSize) {
+    case 2U * 1024U * 1024U:
+        return "2MB";
+
+    case 1024U * 1024U * 1024U:
+        return "1GB";
+
+    case 64U * 1024U:
+        return "64KB";
+
+    case 32U * 1024U * 1024U:
+        return "32MB";
+
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::Cgroup::Cgroup(const char *root, const char *self) :
+    m_root(root)
+{
+#   ifdef XMRIG_OS_LINUX
+    std::ifstream file(m_root + "/cgroup.controllers");
+    m_v2 = file.is_open();
+
+    parse(self);
+    readCpus();
+    readCpuQuota();
+    readMemory();
+#   else
+    (void) self;
+#   endif
+}
+
+
+// XMRIG_CGROUP_ROOT and XMRIG_CGROUP_SELF replace the cgroupfs mount and the self file, the same way HWLOC_XMLFILE fakes the topology,
+// doc/cgroup has v1 and v2 trees for them.
+const xmrig::Cgroup &xmrig::Cgroup::process()
+{
+    static const char *root     = getenv("XMRIG_CGROUP_ROOT");
+    static const char *self     = getenv("XMRIG_CGROUP_SELF");
+    static const Cgroup cgroup(root ? root : kRoot, self ? self : kSelf);
+
+    return cgroup;
+}
+
+
+uint64_t xmrig::Cgroup::totalMemory()
+{
+    return std::min<uint64_t>(uv_get_total_memory(), process().memory());
+}
+
+
+bool xmrig::Cgroup::isAllowed(int64_t cpu) const
+{
+    return m_cpus.empty() || cpu < 0 || std::find(m_cpus.begin(), m_cpus.end(), cpu) != m_cpus.end();
+}
+
+
+// A fractional quota is rounded down, a thread that only gets part of a CPU time slice is throttled every period.
+uint32_t xmrig::Cgroup::maxThreads() const
+{
+    uint32_t count = m_cpus.empty() ? 0 : static_cast<uint32_t>(m_cpus.size());
+
+    if (m_cpuQuota > 0.0) {
+        const auto quota = std::max<uint32_t>(static_cast<uint32_t>(std::floor(m_cpuQuota)), 1);
+
+        count = count ? std::min(count, quota) : quota;
+    }
+
+    return count;
+}
+
+
+uint64_t xmrig::Cgroup::hugePages(size_t hugePageSize) const
+{
+    return hugetlb(hugePageSize, true);
+}
+
+
+uint64_t xmrig::Cgroup::hugePagesLimit(size_t hugePageSize) const
+{
+    return hugetlb(hugePageSize, false);
+}
+
+
+std::string xmrig::Cgroup::path(const char *controller) const
+{
+    for (const auto &kv : m_paths) {
+        if (kv.first == controller) {
+            return kv.second;
+        }
+    }
+
+    return "/";
+}
+
+
+// The cgroup of the process and its ancestors, limits of every level apply.  In a container with its own cgroup namespace
+// the path is relative to a cgroup that is mounted as the root, so a path that doesn't exist falls back to the root.
+std::vector<std::string> xmrig::Cgroup::hierarchy(const char *controller) const
+{
+    std::vector<std::string> out;
+
+#   ifdef XMRIG_OS_LINUX
+    const std::string base = m_v2 ? m_root : (m_root + "/" + controller);
+    if (!isDir(base)) {
+        return out;
+    }
+
+    std::string relative = path(m_v2 ? "" : controller);
+    while (relative.size() > 1 && relative.back() == '/') {
+        relative.pop_back();
+    }
+
+    if (relative.size() <= 1 || !isDir(base + relative)) {
+        relative.clear();
+    }
+
+    while (true) {
+        out.emplace_back(base + relative);
+
+        if (relative.empty()) {
+            break;
+        }
+
+        relative.resize(relative.rfind('/'));
+    }
+#   else
+    (void) controller;
+#   endif
+
+    return out;
+}
+
+
+uint64_t xmrig::Cgroup::hugetlb(size_t hugePageSize, bool available) const
+{
+    uint64_t out = kUnlimited;
+
+#   ifdef XMRIG_OS_LINUX
+    const char *name = hugetlbName(hugePageSize);
+    if (!name) {
+        return out;
+    }
+
+    const std::string limits = std::string("/hugetlb.") + name + (m_v2 ? ".max" : ".limit_in_bytes");
+    const std::string usage  = std::string("/hugetlb.") + name + (m_v2 ? ".current" : ".usage_in_bytes");
+
+    for (const auto &dir : hierarchy("hugetlb")) {
+        const uint64_t limit = readLimit(dir + limits);
+        if (limit == kUnlimited) {
+            continue;
+        }
+
+        if (!available) {
+            out = std::min(out, limit);
+            continue;
+        }
+
+        uint64_t used = readLimit(dir + usage);
+        if (used == kUnlimited) {
+            used = 0;
+        }
+
+        out = std::min(out, used >= limit ? 0 : limit - used);
+    }
+#   else
+    (void) hugePageSize;
+    (void) available;
+#   endif
+
+    return out;
+}
+
+
+void xmrig::Cgroup::parse(const char *self)
+{
+#   ifdef XMRIG_OS_LINUX
+    std::ifstream file(self);
+    std::string line;
+
+    // hierarchy-ID:controller-list:cgroup-path, v2 has a single line with an empty controller list.
+    while (std::getline(file, line)) {
+        const size_t first  = line.find(':');
+        const size_t second = first == std::string::npos ? std::string::npos : line.find(':', first + 1);
+        if (second == std::string::npos) {
+            continue;
+        }
+
+        const std::string controllers = line.substr(first + 1, second - first - 1);
+        const std::string path        = line.substr(second + 1);
+
+        if (controllers.empty()) {
+            m_paths.emplace_back("", path);
+            continue;
+        }
+
+        size_t start = 0;
+        while (start <= controllers.size()) {
+            const size_t end = std::min(controllers.find(',', start), controllers.size());
+            m_paths.emplace_back(controllers.substr(start, end - start), path);
+            start = end + 1;
+        }
+    }
+#   else
+    (void) self;
+#   endif
+}
+
+
+// The effective cpuset already takes the parents into account, it is read from the nearest level that has it.
+void xmrig::Cgroup::readCpus()
+{
+#   ifdef XMRIG_OS_LINUX
+    for (const auto &dir : hierarchy("cpuset")) {
+        std::string line;
+        if (readLine(dir + (m_v2 ? "/cpuset.cpus.effective" : "/cpuset.effective_cpus"), line) || readLine(dir + "/cpuset.cpus", line)) {
+            m_cpus = parseList(line);
+            break;
+        }
+    }
+
+    if (m_cpus.size() >= std::thread::hardware_concurrency()) {
+        m_cpus.clear();
+    }
+#   endif
+}
+
+
+void xmrig::Cgroup::readCpuQuota()
+{
+#   ifdef XMRIG_OS_LINUX
+    for (const auto &dir : hierarchy("cpu")) {
+        uint64_t quota  = kUnlimited;
+        uint64_t period = 0;
+
+        if (m_v2) {
+            std::string line;
+            if (readLine(dir + "/cpu.max", line) && line.compare(0, 3, "max") != 0) {
+                char *end = nullptr;
+                quota     = strtoull(line.c_str(), &end, 10);
+                period    = strtoull(end, nullptr, 10);
+            }
+        }
+        else {
+            quota  = readLimit(dir + "/cpu.cfs_quota_us");
+            period = readLimit(dir + "/cpu.cfs_period_us");
+        }
+
+        if (quota == kUnlimited || quota == 0 || period == 0 || period == kUnlimited) {
+            continue;
+        }
+
+        const double cpus = static_cast<double>(quota) / static_cast<double>(period);
+        m_cpuQuota = m_cpuQuota > 0.0 ? std::min(m_cpuQuota, cpus) : cpus;
+    }
+#   endif
+}
+
+
+void xmrig::Cgroup::readMemory()
+{
+#   ifdef XMRIG_OS_LINUX
+    for (const auto &dir : hierarchy("memory")) {
+        m_memory = std::min(m_memory, readLimit(dir + (m_v2 ? "/memory.max" : "/memory.limit_in_bytes")));
+    }
+#   endif
+}
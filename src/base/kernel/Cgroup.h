@@ -0,0 +1,79 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CGROUP_H
+#define XMRIG_CGROUP_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// Resource limits of the cgroup (v1 or v2) the process runs in, everything is unlimited on other platforms.
+class Cgroup
+{
+public:
+    static const char *kRoot;
+    static const char *kSelf;
+    static constexpr uint64_t kUnlimited = UINT64_MAX;
+
+    // root is the cgroupfs mount point, self lists the cgroups of the process in /proc/<pid>/cgroup format.
+    Cgroup(const char *root = kRoot, const char *self = kSelf);
+
+    static const Cgroup &process();
+    static uint64_t totalMemory();
+
+    inline bool isLimited() const                   { return !m_cpus.empty() || m_cpuQuota > 0.0 || m_memory != kUnlimited; }
+    inline bool isV2() const                        { return m_v2; }
+    inline const std::vector<int32_t> &cpus() const { return m_cpus; }
+    inline double cpuQuota() const                  { return m_cpuQuota; }
+    inline uint64_t memory() const                  { return m_memory; }
+
+    bool isAllowed(int64_t cpu) const;
+    uint32_t maxThreads() const;
+    uint64_t hugePages(size_t hugePageSize) const;
+    uint64_t hugePagesLimit(size_t hugePageSize) const;
+
+private:
+    std::string path(const char *controller) const;
+    std::vector<std::string> hierarchy(const char *controller) const;
+    uint64_t hugetlb(size_t hugePageSize, bool available) const;
+    void parse(const char *self);
+    void readCpus();
+    void readCpuQuota();
+    void readMemory();
+
+    bool m_v2           = false;
+    double m_cpuQuota   = 0.0;
+    std::string m_root;
+    std::vector<int32_t> m_cpus;
+    std::vector<std::pair<std::string, std::string> > m_paths;
+    uint64_t m_memory   = kUnlimited;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CGROUP_H */
@@ -93,8 +93,19 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
     m_tls = reader.getValue(kTls);
 #   endif
 
-    Log::setColors(reader.getBool(kColors, Log::isColors()));
-    setVerbose(reader.getValue(kVerbose));
+    // Only stored here, a reload reads the config off the event loop and the log globals are applied by applyLog() on it.
+    const auto &colors = reader.getValue(kColors);
+    if (colors.IsBool()) {
+        m_colors = colors.GetBool() ? 1 : 0;
+    }
+
+    const auto &verbose = reader.getValue(kVerbose);
+    if (verbose.IsBool()) {
+        m_verbose = verbose.GetBool() ? 1 : 0;
+    }
+    else if (verbose.IsUint()) {
+        m_verbose = verbose.GetUint();
+    }
 
     const auto &api = reader.getObject(kApi);
     if (api.IsObject()) {
@@ -109,6 +120,18 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
 }
 
 
+bool xmrig::BaseConfig::isColors() const
+{
+    return m_colors < 0 ? Log::isColors() : m_colors > 0;
+}
+
+
+uint32_t xmrig::BaseConfig::verbose() const
+{
+    return m_verbose < 0 ? Log::verbose() : static_cast<uint32_t>(m_verbose);
+}
+
+
 bool xmrig::BaseConfig::save()
 {
     if (m_fileName.isNull()) {
@@ -164,12 +187,14 @@ void xmrig::BaseConfig::printVersions()
 }
 
 
-void xmrig::BaseConfig::setVerbose(const rapidjson::Value &value)
+// Options that are not set in the config keep the current log settings.
+void xmrig::BaseConfig::applyLog() const
 {
-    if (value.IsBool()) {
-        Log::setVerbose(value.GetBool() ? 1 : 0);
+    if (m_colors >= 0) {
+        Log::setColors(m_colors > 0);
     }
-    else if (value.IsUint()) {
-        Log::setVerbose(value.GetUint());
+
+    if (m_verbose >= 0) {
+        Log::setVerbose(static_cast<uint32_t>(m_verbose));
     }
 }
@@ -86,6 +86,9 @@ public:
     bool read(const IJsonReader &reader, const char *fileName) override;
     bool save() override;
 
+    bool isColors() const;
+    uint32_t verbose() const;
+    void applyLog() const;
     void printVersions();
 
 protected:
@@ -96,6 +99,8 @@ protected:
     bool m_upgrade          = false;
     bool m_watch            = true;
     Http m_http;
+    int m_colors            = -1;
+    int64_t m_verbose       = -1;
     Pools m_pools;
     String m_apiId;
     String m_apiWorkerId;
@@ -108,9 +113,6 @@ protected:
 #   ifdef XMRIG_FEATURE_TLS
     TlsConfig m_tls;
 #   endif
-
-private:
-    void setVerbose(const rapidjson::Value &value);
 };
 
 
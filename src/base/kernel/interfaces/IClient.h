@@ -75,6 +75,8 @@ public:
     virtual int64_t send(const rapidjson::Value &obj)                       = 0;
     virtual int64_t sequence() const                                        = 0;
     virtual int64_t submit(const JobResult &result)                         = 0;
+    virtual uint64_t rx() const                                             = 0;
+    virtual uint64_t tx() const                                             = 0;
     virtual void connect()                                                  = 0;
     virtual void connect(const Pool &pool)                                  = 0;
     virtual void deleteLater()                                              = 0;
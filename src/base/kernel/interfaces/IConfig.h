@@ -82,6 +82,14 @@ public:
         HugePageSizeKey      = 1050,
         PauseOnActiveKey     = 1051,
         SubmitToOriginKey    = 1052,
+        TopologyCacheKey     = 1053,
+        JobBacklogKey        = 1054,
+        ReplayKey            = 1055,
+        ReplayReportKey      = 1056,
+        MinDiffKey           = 1057,
+        PressureKey          = 1058,
+        PressureCgroupKey    = 1059,
+        WeightKey            = 1060,
 
         // xmrig common
         CPUPriorityKey       = 1021,
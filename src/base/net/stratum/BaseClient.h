@@ -55,6 +55,8 @@ protected:
     inline const String &ip() const override                   { return m_ip; }
     inline int id() const override                             { return m_id; }
     inline int64_t sequence() const override                   { return m_sequence; }
+    inline uint64_t rx() const override                        { return m_rx; }
+    inline uint64_t tx() const override                        { return m_tx; }
     inline void setAlgo(const Algorithm &algo) override        { m_pool.setAlgo(algo); }
     inline void setEnabled(bool enabled) override              { m_enabled = enabled; }
     inline void setProxy(const ProxyUrl &proxy) override       { m_pool.setProxy(proxy); }
@@ -103,6 +105,8 @@ protected:
     String m_rigId;
     String m_user;
     uint64_t m_retryPause           = 5000;
+    uint64_t m_rx                   = 0;
+    uint64_t m_tx                   = 0;
 
     static int64_t m_sequence;
 
@@ -502,6 +502,8 @@ bool xmrig::Client::write(const uv_buf_t &buf)
 {
     const int rc = uv_try_write(stream(), &buf, 1);
     if (static_cast<size_t>(rc) == buf.len) {
+        m_tx += buf.len;
+
         return true;
     }
 
@@ -868,6 +870,8 @@ void xmrig::Client::read(ssize_t nread, const uv_buf_t *buf)
         return;
     }
 
+    m_rx += size;
+
     assert(m_listener != nullptr);
     if (!m_listener) {
         return reconnect();
@@ -143,6 +143,9 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("avg_time",        avgTime() / 1000, allocator);
     connection.AddMember("avg_time_ms",     avgTime(), allocator);
     connection.AddMember("hashes_total",    m_hashes, allocator);
+    connection.AddMember("share_rate",      shareRate(), allocator);
+    connection.AddMember("rx",              m_rx, allocator);
+    connection.AddMember("tx",              m_tx, allocator);
 
     if (version == 1) {
         connection.AddMember("error_log", Value(kArrayType), allocator);
@@ -200,6 +203,8 @@ void xmrig::NetworkState::printConnection() const
     printDiff(m_diff);
     printLatency(latency());
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%" PRIu64 "s"), "connection time", connectionTime() / 1000);
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%.2f/min"), "share rate", shareRate());
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%" PRIu64 " KB ") BLACK_BOLD("rx ") CYAN_BOLD("%" PRIu64 " KB ") BLACK_BOLD("tx"), "traffic", m_rx / 1024, m_tx / 1024);
 }
 
 
@@ -271,6 +276,8 @@ void xmrig::NetworkState::onActive(IStrategy *strategy, IClient *client)
     m_fingerprint    = client->tlsFingerprint();
     m_active         = true;
     m_connectionTime = Chrono::steadyMSecs();
+    m_rxBase         = client->rx();
+    m_txBase         = client->tx();
 
     StrategyProxy::onActive(strategy, client);
 }
@@ -281,6 +288,8 @@ void xmrig::NetworkState::onJob(IStrategy *strategy, IClient *client, const Job
     m_algorithm = job.algorithm();
     m_diff      = job.diff();
 
+    traffic(client);
+
     StrategyProxy::onJob(strategy, client, job, params);
 }
 
@@ -298,6 +307,7 @@ void xmrig::NetworkState::onPause(IStrategy *strategy)
 void xmrig::NetworkState::onResultAccepted(IStrategy *strategy, IClient *client, const SubmitResult &result, const char *error)
 {
     add(result, error);
+    traffic(client);
 
     StrategyProxy::onResultAccepted(strategy, client, result, error);
 }
@@ -317,6 +327,14 @@ uint32_t xmrig::NetworkState::latency() const
 }
 
 
+double xmrig::NetworkState::shareRate() const
+{
+    const uint64_t time = connectionTime();
+
+    return time ? m_latency.size() * 60000.0 / time : 0.0;
+}
+
+
 uint64_t xmrig::NetworkState::avgTime() const
 {
     if (m_latency.empty()) {
@@ -353,6 +371,13 @@ void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
 }
 
 
+void xmrig::NetworkState::traffic(const IClient *client)
+{
+    m_rx = client->rx() - m_rxBase;
+    m_tx = client->tx() - m_txBase;
+}
+
+
 void xmrig::NetworkState::stop()
 {
     m_active      = false;
@@ -360,6 +385,8 @@ void xmrig::NetworkState::stop()
     m_ip          = nullptr;
     m_tls         = nullptr;
     m_fingerprint = nullptr;
+    m_rx          = 0;
+    m_tx          = 0;
 
     m_failures++;
     m_latency.clear();
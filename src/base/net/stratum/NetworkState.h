@@ -67,8 +67,10 @@ protected:
 
 private:
     uint32_t latency() const;
+    double shareRate() const;
     uint64_t avgTime() const;
     uint64_t connectionTime() const;
+    void traffic(const IClient *client);
     void add(const SubmitResult &result, const char *error);
     void stop();
 
@@ -86,6 +88,10 @@ private:
     uint64_t m_failures         = 0;
     uint64_t m_hashes           = 0;
     uint64_t m_rejected         = 0;
+    uint64_t m_rx               = 0;
+    uint64_t m_rxBase           = 0;
+    uint64_t m_tx               = 0;
+    uint64_t m_txBase           = 0;
 };
 
 
@@ -44,6 +44,10 @@
 #endif
 
 
+#include "base/net/stratum/replay/ReplayClient.h"
+#include "base/net/stratum/replay/ReplayConfig.h"
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "base/net/stratum/benchmark/BenchClient.h"
 #   include "base/net/stratum/benchmark/BenchConfig.h"
@@ -69,6 +73,7 @@ const char *Pool::kDaemonPollInterval     = "daemon-poll-interval";
 const char *Pool::kEnabled                = "enabled";
 const char *Pool::kFingerprint            = "tls-fingerprint";
 const char *Pool::kKeepalive              = "keepalive";
+const char *Pool::kMinDiff                = "min-diff";
 const char *Pool::kNicehash               = "nicehash";
 const char *Pool::kPass                   = "pass";
 const char *Pool::kRigId                  = "rig-id";
@@ -78,6 +83,7 @@ const char *Pool::kSubmitToOrigin         = "submit-to-origin";
 const char *Pool::kTls                    = "tls";
 const char *Pool::kUrl                    = "url";
 const char *Pool::kUser                   = "user";
+const char *Pool::kWeight                 = "weight";
 const char *Pool::kNicehashHost           = "nicehash.com";
 
 
@@ -120,6 +126,8 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_rigId        = Json::getString(object, kRigId);
     m_fingerprint  = Json::getString(object, kFingerprint);
     m_pollInterval = Json::getUint64(object, kDaemonPollInterval, kDefaultPollInterval);
+    m_minDiff      = Json::getUint64(object, kMinDiff);
+    m_weight       = Json::getUint(object, kWeight);
     m_algorithm    = Json::getString(object, kAlgo);
     m_coin         = Json::getString(object, kCoin);
     m_daemon       = Json::getString(object, kSelfSelect);
@@ -141,6 +149,15 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
 }
 
 
+xmrig::Pool::Pool(const std::shared_ptr<ReplayConfig> &replay) :
+    m_mode(MODE_REPLAY),
+    m_flags(1 << FLAG_ENABLED),
+    m_url(ReplayConfig::kField),
+    m_replay(replay)
+{
+}
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 xmrig::Pool::Pool(const std::shared_ptr<BenchConfig> &benchmark) :
     m_mode(MODE_BENCHMARK),
@@ -207,6 +224,8 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_url          == other.m_url
             && m_user         == other.m_user
             && m_pollInterval == other.m_pollInterval
+            && m_minDiff      == other.m_minDiff
+            && m_weight       == other.m_weight
             && m_daemon       == other.m_daemon
             && m_proxy        == other.m_proxy
             );
@@ -241,6 +260,9 @@ xmrig::IClient *xmrig::Pool::createClient(int id, IClientListener *listener) con
         client = new AutoClient(id, Platform::userAgent(), listener);
     }
 #   endif
+    else if (m_mode == MODE_REPLAY) {
+        client = new ReplayClient(m_replay, listener);
+    }
 #   ifdef XMRIG_FEATURE_BENCHMARK
     else if (m_mode == MODE_BENCHMARK) {
         client = new BenchClient(m_benchmark, listener);
@@ -284,6 +306,9 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
         else {
             obj.AddMember(StringRef(kKeepalive), m_keepAlive, allocator);
         }
+
+        obj.AddMember(StringRef(kMinDiff), m_minDiff, allocator);
+        obj.AddMember(StringRef(kWeight),  m_weight, allocator);
     }
 
     obj.AddMember(StringRef(kEnabled),      m_flags.test(FLAG_ENABLED), allocator);
@@ -318,6 +343,17 @@ std::string xmrig::Pool::printableName() const
     if (m_mode == MODE_SELF_SELECT) {
         out += std::string(" self-select ") + CSI "1;" + std::to_string(m_daemon.isTLS() ? 32 : 36) + "m" + m_daemon.url().data() + WHITE_BOLD_S + (m_submitToOrigin ? " submit-to-origin" : "") + CLEAR;
     }
+    else if (m_mode == MODE_REPLAY) {
+        out += std::string(" file ") + WHITE_BOLD_S + m_replay->file().data() + CLEAR;
+    }
+
+    if (m_minDiff) {
+        out += std::string(" min-diff ") + WHITE_BOLD_S + std::to_string(m_minDiff) + CLEAR;
+    }
+
+    if (m_weight) {
+        out += std::string(" weight ") + WHITE_BOLD_S + std::to_string(m_weight) + CLEAR;
+    }
 
     return out;
 }
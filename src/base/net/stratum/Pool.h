@@ -37,6 +37,7 @@ namespace xmrig {
 class BenchConfig;
 class IClient;
 class IClientListener;
+class ReplayConfig;
 
 
 class Pool
@@ -47,6 +48,7 @@ public:
         MODE_DAEMON,
         MODE_SELF_SELECT,
         MODE_AUTO_ETH,
+        MODE_REPLAY,
 #       ifdef XMRIG_FEATURE_BENCHMARK
         MODE_BENCHMARK,
 #       endif
@@ -62,6 +64,7 @@ public:
     static const char *kEnabled;
     static const char *kFingerprint;
     static const char *kKeepalive;
+    static const char *kMinDiff;
     static const char *kNicehash;
     static const char *kPass;
     static const char *kRigId;
@@ -71,6 +74,7 @@ public:
     static const char *kTls;
     static const char *kUrl;
     static const char *kUser;
+    static const char *kWeight;
     static const char *kNicehashHost;
 
     constexpr static int kKeepAliveTimeout         = 60;
@@ -81,6 +85,7 @@ public:
     Pool(const char *host, uint16_t port, const char *user, const char *password, int keepAlive, bool nicehash, bool tls, Mode mode);
     Pool(const char *url);
     Pool(const rapidjson::Value &object);
+    Pool(const std::shared_ptr<ReplayConfig> &replay);
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     Pool(const std::shared_ptr<BenchConfig> &benchmark);
@@ -105,7 +110,9 @@ public:
     inline int keepAlive() const                        { return m_keepAlive; }
     inline Mode mode() const                            { return m_mode; }
     inline uint16_t port() const                        { return m_url.port(); }
+    inline uint64_t minDiff() const                     { return m_minDiff; }
     inline uint64_t pollInterval() const                { return m_pollInterval; }
+    inline uint32_t weight() const                      { return m_weight; }
     inline void setAlgo(const Algorithm &algorithm)     { m_algorithm = algorithm; }
     inline void setPassword(const String &password)     { m_password = password; }
     inline void setProxy(const ProxyUrl &proxy)         { m_proxy = proxy; }
@@ -149,9 +156,12 @@ private:
     String m_password;
     String m_rigId;
     String m_user;
+    uint64_t m_minDiff              = 0;
     uint64_t m_pollInterval         = kDefaultPollInterval;
+    uint32_t m_weight               = 0;
     Url m_daemon;
     Url m_url;
+    std::shared_ptr<ReplayConfig> m_replay;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     std::shared_ptr<BenchConfig> m_benchmark;
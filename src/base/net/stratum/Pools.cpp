@@ -27,8 +27,10 @@
 #include "3rdparty/rapidjson/document.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
+#include "base/net/stratum/replay/ReplayConfig.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
+#include "base/net/stratum/strategies/WeightedStrategy.h"
 #include "donate.h"
 
 
@@ -72,6 +74,10 @@ bool xmrig::Pools::isEqual(const Pools &other) const
 
 int xmrig::Pools::donateLevel() const
 {
+    if (m_replay) {
+        return 0;
+    }
+
 #   ifdef XMRIG_FEATURE_BENCHMARK
     return benchSize() || (m_benchmark && !m_benchmark->id().isEmpty()) ? 0 : m_donateLevel;
 #   else
@@ -82,6 +88,17 @@ int xmrig::Pools::donateLevel() const
 
 xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) const
 {
+    if (weights().size() > 1) {
+        auto strategy = new WeightedStrategy(retryPause(), retries(), listener);
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled() && pool.weight() > 0 && strategy->count() < kMaxWeighted) {
+                strategy->add(pool);
+            }
+        }
+
+        return strategy;
+    }
+
     if (active() == 1) {
         for (const Pool &pool : m_data) {
             if (pool.isEnabled()) {
@@ -142,6 +159,13 @@ void xmrig::Pools::load(const IJsonReader &reader)
     }
 #   endif
 
+    m_replay = std::shared_ptr<ReplayConfig>(ReplayConfig::create(reader.getObject(ReplayConfig::kField)));
+    if (m_replay) {
+        m_data.emplace_back(m_replay);
+
+        return;
+    }
+
     const rapidjson::Value &pools = reader.getArray(kPools);
     if (!pools.IsArray()) {
         return;
@@ -165,6 +189,25 @@ void xmrig::Pools::load(const IJsonReader &reader)
 }
 
 
+// Weights of the enabled pools mined at the same time, empty unless at least two pools have a weight.
+std::vector<uint32_t> xmrig::Pools::weights() const
+{
+    std::vector<uint32_t> out;
+
+    for (const Pool &pool : m_data) {
+        if (pool.isEnabled() && pool.weight() > 0 && out.size() < kMaxWeighted) {
+            out.push_back(pool.weight());
+        }
+    }
+
+    if (out.size() < 2) {
+        out.clear();
+    }
+
+    return out;
+}
+
+
 uint32_t xmrig::Pools::benchSize() const
 {
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -207,6 +250,12 @@ void xmrig::Pools::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
     }
 #   endif
 
+    if (m_replay) {
+        out.AddMember(StringRef(ReplayConfig::kField), m_replay->toJSON(doc), allocator);
+
+        return;
+    }
+
     doc.AddMember(StringRef(kDonateLevel),      m_donateLevel, allocator);
     doc.AddMember(StringRef(kDonateOverProxy),  m_proxyDonate, allocator);
     out.AddMember(StringRef(kPools),            toJSON(doc), allocator);
@@ -49,6 +49,8 @@ public:
     static const char *kRetries;
     static const char *kRetryPause;
 
+    constexpr static size_t kMaxWeighted = 8;
+
     enum ProxyDonate {
         PROXY_DONATE_NONE,
         PROXY_DONATE_AUTO,
@@ -70,6 +72,7 @@ public:
     IStrategy *createStrategy(IStrategyListener *listener) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t active() const;
+    std::vector<uint32_t> weights() const;
     uint32_t benchSize() const;
     void load(const IJsonReader &reader);
     void print() const;
@@ -85,6 +88,7 @@ private:
     int m_retries               = 5;
     int m_retryPause            = 5;
     ProxyDonate m_proxyDonate   = PROXY_DONATE_AUTO;
+    std::shared_ptr<ReplayConfig> m_replay;
     std::vector<Pool> m_data;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
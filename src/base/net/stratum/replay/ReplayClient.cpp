@@ -0,0 +1,292 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/replay/ReplayClient.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/net/stratum/replay/ReplayConfig.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/tools/Timer.h"
+#include "net/JobResult.h"
+
+
+#include <csignal>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+static const char *kClientId            = "replay";
+static const char *kJobs                = "jobs";
+static constexpr int kFinishTimer       = -1;
+static constexpr uint64_t kDefaultTail  = 10000;
+
+
+} // namespace xmrig
+
+
+xmrig::ReplayClient::ReplayClient(const std::shared_ptr<ReplayConfig> &replay, IClientListener *listener) :
+    BaseClient(0, listener),
+    m_replay(replay)
+{
+    m_timer = new Timer(this);
+}
+
+
+xmrig::ReplayClient::~ReplayClient()
+{
+    delete m_timer;
+}
+
+
+bool xmrig::ReplayClient::disconnect()
+{
+    m_timer->stop();
+    m_state = UnconnectedState;
+
+    return true;
+}
+
+
+int64_t xmrig::ReplayClient::submit(const JobResult &result)
+{
+    if (result.clientId != kClientId) {
+        return -1;
+    }
+
+    Stats *stats = this->stats(result.jobId);
+    if (!stats) {
+        return -1;
+    }
+
+    const uint64_t now     = Chrono::steadyMSecs();
+    const uint64_t latency = now - result.timestamp;
+    const bool stale       = result.jobId != m_job.id();
+
+    if (stats->results == 0) {
+        stats->firstResult = result.timestamp - m_startTime - stats->at;
+    }
+
+    stats->results++;
+    stats->latency   += latency;
+    stats->latencyMax = std::max(stats->latencyMax, latency);
+
+    if (stale) {
+        stats->stale++;
+    }
+
+#   ifdef XMRIG_PROXY_PROJECT
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), result.id, 0);
+#   else
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
+#   endif
+
+    handleSubmitResponse(m_sequence, stale ? "stale share" : nullptr);
+
+    return m_sequence++;
+}
+
+
+void xmrig::ReplayClient::connect()
+{
+    if (!load()) {
+        uv_kill(uv_os_getpid(), SIGTERM);
+
+        return;
+    }
+
+    m_state     = ConnectedState;
+    m_startTime = Chrono::steadyMSecs();
+    m_index     = 0;
+
+    m_stats.clear();
+    m_seed = nullptr;
+
+    m_listener->onLoginSuccess(this);
+
+    next();
+}
+
+
+void xmrig::ReplayClient::connect(const Pool &pool)
+{
+    setPool(pool);
+    connect();
+}
+
+
+void xmrig::ReplayClient::onTimer(const Timer *timer)
+{
+    if (timer->id() == kFinishTimer) {
+        return finish();
+    }
+
+    const rapidjson::Value &jobs = m_doc[kJobs];
+    if (parseJob(jobs[static_cast<rapidjson::SizeType>(m_index)])) {
+        m_listener->onJobReceived(this, m_job, jobs[static_cast<rapidjson::SizeType>(m_index)]);
+    }
+
+    m_index++;
+    next();
+}
+
+
+bool xmrig::ReplayClient::load()
+{
+    if (!Json::get(m_replay->file(), m_doc) || !m_doc.IsObject() || !m_doc.HasMember(kJobs) || !m_doc[kJobs].IsArray() || m_doc[kJobs].Empty()) {
+        LOG_ERR("%s " RED("failed to load replay file ") RED_BOLD("\"%s\""), tag(), m_replay->file().data());
+
+        return false;
+    }
+
+    m_duration = Json::getUint64(m_doc, "duration", kDefaultTail);
+
+    LOG_INFO("%s " WHITE_BOLD("loaded %u jobs from ") CYAN_BOLD("\"%s\""), tag(), m_doc[kJobs].Size(), m_replay->file().data());
+
+    return true;
+}
+
+
+bool xmrig::ReplayClient::parseJob(const rapidjson::Value &params)
+{
+    Job job(false, m_pool.algorithm(), kClientId);
+
+    if (!job.setId(Json::getString(params, "job_id")) || !job.setBlob(Json::getString(params, "blob")) || !job.setTarget(Json::getString(params, "target"))) {
+        LOG_ERR("%s " RED("invalid job #%zu"), tag(), m_index);
+
+        return false;
+    }
+
+    const char *algo = Json::getString(params, "algo");
+    if (algo) {
+        job.setAlgorithm(algo);
+    }
+
+    job.setHeight(Json::getUint64(params, "height"));
+
+    const char *seed = Json::getString(params, "seed_hash");
+    if (job.algorithm().family() == Algorithm::RANDOM_X && !job.setSeedHash(seed)) {
+        LOG_ERR("%s " RED("invalid seed hash in job #%zu"), tag(), m_index);
+
+        return false;
+    }
+
+    Stats stats;
+    stats.algorithm   = job.algorithm();
+    stats.id          = job.id();
+    stats.diff        = job.diff();
+    stats.height      = job.height();
+    stats.at          = Chrono::steadyMSecs() - m_startTime;
+    stats.seedChanged = !m_seed.isNull() && m_seed != seed;
+
+    m_stats.push_back(std::move(stats));
+    m_seed = seed;
+    m_job  = std::move(job);
+
+    return true;
+}
+
+
+xmrig::ReplayClient::Stats *xmrig::ReplayClient::stats(const String &id)
+{
+    for (auto it = m_stats.rbegin(); it != m_stats.rend(); ++it) {
+        if (it->id == id) {
+            return &*it;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void xmrig::ReplayClient::finish()
+{
+    uint64_t results = 0;
+    uint64_t stale   = 0;
+    uint64_t latency = 0;
+
+    for (const auto &stats : m_stats) {
+        results += stats.results;
+        stale   += stats.stale;
+        latency += stats.latency;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("finished, jobs ") CYAN_BOLD("%zu") WHITE_BOLD(" results ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" stale ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" avg latency ") CYAN_BOLD("%" PRIu64 " ms"),
+             tag(), m_stats.size(), results, stale, results ? latency / results : 0);
+
+    if (!m_replay->report().isEmpty()) {
+        save();
+    }
+
+    disconnect();
+    uv_kill(uv_os_getpid(), SIGTERM);
+}
+
+
+void xmrig::ReplayClient::next()
+{
+    const rapidjson::Value &jobs = m_doc[kJobs];
+    if (m_index >= jobs.Size()) {
+        return m_timer->singleShot(m_duration, kFinishTimer);
+    }
+
+    const uint64_t at      = Json::getUint64(jobs[static_cast<rapidjson::SizeType>(m_index)], "at");
+    const uint64_t elapsed = Chrono::steadyMSecs() - m_startTime;
+
+    m_timer->singleShot(at > elapsed ? at - elapsed : 0);
+}
+
+
+void xmrig::ReplayClient::save() const
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    Value jobs(kArrayType);
+    for (const auto &stats : m_stats) {
+        Value job(kObjectType);
+        job.AddMember("job_id",         stats.id.toJSON(doc), allocator);
+        job.AddMember("algo",           stats.algorithm.toJSON(), allocator);
+        job.AddMember("height",         stats.height, allocator);
+        job.AddMember("diff",           stats.diff, allocator);
+        job.AddMember("at",             stats.at, allocator);
+        job.AddMember("seed_changed",   stats.seedChanged, allocator);
+        job.AddMember("first_result",   stats.results ? Value(stats.firstResult) : Value(kNullType), allocator);
+        job.AddMember("results",        stats.results, allocator);
+        job.AddMember("stale",          stats.stale, allocator);
+        job.AddMember("latency_avg",    stats.results ? stats.latency / stats.results : 0, allocator);
+        job.AddMember("latency_max",    stats.latencyMax, allocator);
+
+        jobs.PushBack(job, allocator);
+    }
+
+    doc.AddMember("file",       m_replay->file().toJSON(doc), allocator);
+    doc.AddMember("duration",   Chrono::steadyMSecs() - m_startTime, allocator);
+    doc.AddMember(StringRef(kJobs), jobs, allocator);
+
+    if (!Json::save(m_replay->report(), doc)) {
+        LOG_ERR("%s " RED("failed to save replay report ") RED_BOLD("\"%s\""), tag(), m_replay->report().data());
+    }
+}
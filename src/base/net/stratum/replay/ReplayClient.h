@@ -0,0 +1,103 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_REPLAYCLIENT_H
+#define XMRIG_REPLAYCLIENT_H
+
+
+#include "3rdparty/rapidjson/document.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/stratum/BaseClient.h"
+#include "base/tools/Object.h"
+
+
+#include <memory>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class ReplayConfig;
+
+
+class ReplayClient : public BaseClient, public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ReplayClient)
+
+    ReplayClient(const std::shared_ptr<ReplayConfig> &replay, IClientListener *listener);
+    ~ReplayClient() override;
+
+protected:
+    bool disconnect() override;
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void connect(const Pool &pool) override;
+
+    void onTimer(const Timer *timer) override;
+
+    inline bool hasExtension(Extension) const noexcept override         { return false; }
+    inline bool isTLS() const override                                  { return false; }
+    inline const char *mode() const override                            { return "replay"; }
+    inline const char *tlsFingerprint() const override                  { return nullptr; }
+    inline const char *tlsVersion() const override                      { return nullptr; }
+    inline int64_t send(const rapidjson::Value &, Callback) override    { return -1; }
+    inline int64_t send(const rapidjson::Value &) override              { return -1; }
+    inline void deleteLater() override                                  { delete this; }
+    inline void tick(uint64_t) override                                 {}
+
+private:
+    struct Stats
+    {
+        Algorithm algorithm;
+        bool seedChanged        = false;
+        String id;
+        uint64_t at             = 0;
+        uint64_t diff           = 0;
+        uint64_t firstResult    = 0;
+        uint64_t height         = 0;
+        uint64_t latency        = 0;
+        uint64_t latencyMax     = 0;
+        uint64_t results        = 0;
+        uint64_t stale          = 0;
+    };
+
+    bool load();
+    bool parseJob(const rapidjson::Value &params);
+    Stats *stats(const String &id);
+    void finish();
+    void next();
+    void save() const;
+
+    const std::shared_ptr<ReplayConfig> m_replay;
+    rapidjson::Document m_doc;
+    size_t m_index          = 0;
+    std::vector<Stats> m_stats;
+    String m_seed;
+    Timer *m_timer;
+    uint64_t m_duration     = 0;
+    uint64_t m_startTime    = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_REPLAYCLIENT_H */
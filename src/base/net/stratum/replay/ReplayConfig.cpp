@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/replay/ReplayConfig.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+namespace xmrig {
+
+
+const char *ReplayConfig::kField    = "replay";
+const char *ReplayConfig::kFile     = "file";
+const char *ReplayConfig::kReport   = "report";
+
+
+} // namespace xmrig
+
+
+xmrig::ReplayConfig::ReplayConfig(const rapidjson::Value &object) :
+    m_file(Json::getString(object, kFile)),
+    m_report(Json::getString(object, kReport))
+{
+}
+
+
+xmrig::ReplayConfig *xmrig::ReplayConfig::create(const rapidjson::Value &object)
+{
+    if (!object.IsObject() || object.ObjectEmpty()) {
+        return nullptr;
+    }
+
+    auto config = new ReplayConfig(object);
+    if (config->file().isEmpty()) {
+        delete config;
+
+        return nullptr;
+    }
+
+    return config;
+}
+
+
+rapidjson::Value xmrig::ReplayConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember(StringRef(kFile),     m_file.toJSON(), allocator);
+    out.AddMember(StringRef(kReport),   m_report.toJSON(), allocator);
+
+    return out;
+}
@@ -0,0 +1,56 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_REPLAYCONFIG_H
+#define XMRIG_REPLAYCONFIG_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class ReplayConfig
+{
+public:
+    static const char *kField;
+    static const char *kFile;
+    static const char *kReport;
+
+    ReplayConfig(const rapidjson::Value &object);
+
+    static ReplayConfig *create(const rapidjson::Value &object);
+
+    inline const String &file() const       { return m_file; }
+    inline const String &report() const     { return m_report; }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    String m_file;
+    String m_report;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_REPLAYCONFIG_H */
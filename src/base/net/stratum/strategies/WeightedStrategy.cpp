@@ -0,0 +1,194 @@
+/* XMRig
+ * Copyright (c) 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/strategies/WeightedStrategy.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "net/JobResult.h"
+
+
+xmrig::WeightedStrategy::WeightedStrategy(int retryPause, int retries, IStrategyListener *listener) :
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::WeightedStrategy::~WeightedStrategy()
+{
+    for (IClient *client : m_pools) {
+        client->deleteLater();
+    }
+}
+
+
+bool xmrig::WeightedStrategy::isActive(size_t partition) const
+{
+    return partition < m_active.size() && m_active[partition];
+}
+
+
+void xmrig::WeightedStrategy::add(const Pool &pool)
+{
+    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+
+    client->setRetries(m_retries);
+    client->setRetryPause(m_retryPause * 1000);
+
+    m_pools.push_back(client);
+    m_active.push_back(false);
+}
+
+
+bool xmrig::WeightedStrategy::isActive() const
+{
+    for (bool active : m_active) {
+        if (active) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+xmrig::IClient *xmrig::WeightedStrategy::client() const
+{
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (m_active[i]) {
+            return m_pools[i];
+        }
+    }
+
+    return m_pools.front();
+}
+
+
+int64_t xmrig::WeightedStrategy::submit(const JobResult &result)
+{
+    // Partition p mines jobs with nonce index 2 + p, see Miner::setJob().
+    const size_t partition = result.index >= 2 ? result.index - 2U : 0;
+    if (!isActive(partition)) {
+        return -1;
+    }
+
+    return m_pools[partition]->submit(result);
+}
+
+
+void xmrig::WeightedStrategy::connect()
+{
+    for (IClient *client : m_pools) {
+        client->connect();
+    }
+}
+
+
+void xmrig::WeightedStrategy::resume()
+{
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (m_active[i]) {
+            m_listener->onJob(this, m_pools[i], m_pools[i]->job(), rapidjson::Value(rapidjson::kNullType));
+        }
+    }
+}
+
+
+void xmrig::WeightedStrategy::setAlgo(const Algorithm &algo)
+{
+    for (IClient *client : m_pools) {
+        client->setAlgo(algo);
+    }
+}
+
+
+void xmrig::WeightedStrategy::setProxy(const ProxyUrl &proxy)
+{
+    for (IClient *client : m_pools) {
+        client->setProxy(proxy);
+    }
+}
+
+
+void xmrig::WeightedStrategy::stop()
+{
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        m_pools[i]->disconnect();
+        m_active[i] = false;
+    }
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::WeightedStrategy::tick(uint64_t now)
+{
+    for (IClient *client : m_pools) {
+        client->tick(now);
+    }
+}
+
+
+void xmrig::WeightedStrategy::onClose(IClient *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    const auto id = static_cast<size_t>(client->id());
+    if (m_active[id]) {
+        m_active[id] = false;
+        m_listener->onPause(this);
+    }
+}
+
+
+void xmrig::WeightedStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)
+{
+    if (m_active[static_cast<size_t>(client->id())]) {
+        m_listener->onJob(this, client, job, params);
+    }
+}
+
+
+void xmrig::WeightedStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::WeightedStrategy::onLoginSuccess(IClient *client)
+{
+    m_active[static_cast<size_t>(client->id())] = true;
+    m_listener->onActive(this, client);
+}
+
+
+void xmrig::WeightedStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::WeightedStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
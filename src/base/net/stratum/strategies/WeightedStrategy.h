@@ -0,0 +1,82 @@
+/* XMRig
+ * Copyright (c) 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_WEIGHTEDSTRATEGY_H
+#define XMRIG_WEIGHTEDSTRATEGY_H
+
+
+#include <vector>
+
+
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Pool.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class Client;
+class IStrategyListener;
+
+
+// Keeps every weighted pool connected at once, the client id is the CPU partition its jobs are mined on.
+class WeightedStrategy : public IStrategy, public IClientListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(WeightedStrategy)
+
+    WeightedStrategy(int retryPause, int retries, IStrategyListener *listener);
+    ~WeightedStrategy() override;
+
+    inline size_t count() const { return m_pools.size(); }
+
+    bool isActive(size_t partition) const;
+    void add(const Pool &pool);
+
+protected:
+    bool isActive() const override;
+    IClient *client() const override;
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void resume() override;
+    void setAlgo(const Algorithm &algo) override;
+    void setProxy(const ProxyUrl &proxy) override;
+    void stop() override;
+    void tick(uint64_t now) override;
+
+    void onClose(IClient *client, int failures) override;
+    void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params) override;
+    void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *client) override;
+    void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
+    void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
+
+private:
+    const int m_retries;
+    const int m_retryPause;
+    IStrategyListener *m_listener;
+    std::vector<bool> m_active;
+    std::vector<IClient*> m_pools;
+};
+
+
+} /* namespace xmrig */
+
+#endif /* XMRIG_WEIGHTEDSTRATEGY_H */
@@ -0,0 +1,4 @@
+if (WITH_BENCH)
+    add_executable(xlarig-bench src/bench/xlarig-bench.cpp $<TARGET_OBJECTS:xlarig-rx-core>)
+    target_link_libraries(xlarig-bench ${RX_CORE_LIBRARIES})
+endif()
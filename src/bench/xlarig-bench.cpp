@@ -0,0 +1,639 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Microbenchmarks for the RandomX/Panthera building blocks, each primitive is timed in isolation
+ * on a single pinned thread after a warm-up pass.
+ *
+ * usage: xlarig-bench [--algo ALGO] [--cpu N] [--scale X] [--filter TEXT] [--json FILE] [--dataset] [--vms N]
+ */
+
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/prettywriter.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "backend/cpu/Cpu.h"
+#include "base/crypto/Algorithm.h"
+#include "base/io/json/Json.h"
+#include "base/kernel/Platform.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/aes_hash.hpp"
+#include "crypto/randomx/blake2/blake2.h"
+#include "crypto/randomx/blake2_generator.hpp"
+#include "crypto/randomx/dataset.hpp"
+#include "crypto/randomx/jit_compiler.hpp"
+#include "crypto/randomx/program.hpp"
+#include "crypto/randomx/randomx.h"
+#include "crypto/randomx/superscalar.hpp"
+#include "crypto/rx/RxAlgo.h"
+
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+#if defined(_M_X64) || defined(__x86_64__)
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#   define XLARIG_BENCH_TSC
+#endif
+
+
+#ifdef __linux__
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+
+extern "C" {
+#include "crypto/randomx/panthera/yespower.h"
+#include "crypto/randomx/panthera/KangarooTwelve.h"
+
+extern uint32_t rx_blake2b_use_sse41;
+}
+
+
+namespace xmrig {
+
+
+static inline uint64_t readTSC()
+{
+#   ifdef XLARIG_BENCH_TSC
+    return __rdtsc();
+#   else
+    return 0;
+#   endif
+}
+
+
+static inline uint64_t steadyNSecs()
+{
+    using namespace std::chrono;
+
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+
+// Instruction TLB read misses of the calling thread in user mode, unavailable without perf events.
+class ITlbCounter
+{
+public:
+    ITlbCounter()
+    {
+#       ifdef __linux__
+        perf_event_attr attr{};
+        attr.type           = PERF_TYPE_HW_CACHE;
+        attr.size           = sizeof(attr);
+        attr.config         = PERF_COUNT_HW_CACHE_ITLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#       endif
+    }
+
+    ~ITlbCounter()
+    {
+#       ifdef __linux__
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#       endif
+    }
+
+    inline bool isValid() const { return m_fd >= 0; }
+
+    void start()
+    {
+#       ifdef __linux__
+        if (isValid()) {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#       endif
+    }
+
+    int64_t stop()
+    {
+        uint64_t count = 0;
+
+#       ifdef __linux__
+        if (isValid()) {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            if (read(m_fd, &count, sizeof(count)) == sizeof(count)) {
+                return static_cast<int64_t>(count);
+            }
+        }
+#       endif
+
+        return -1;
+    }
+
+private:
+    int m_fd = -1;
+};
+
+
+class BenchResult
+{
+public:
+    std::string name;
+    std::string variant;
+    uint64_t iterations;
+    uint64_t cycles;
+    uint64_t ns;
+    int64_t itlbMisses;
+};
+
+
+class Bench
+{
+public:
+    std::string filter;
+    double scale = 1.0;
+    std::vector<BenchResult> results;
+    ITlbCounter itlb;
+
+
+    // Whether a benchmark named name may pass the filter, used to skip expensive setup.
+    bool wants(const char *name) const
+    {
+        return filter.empty() || std::string(name).find(filter) != std::string::npos || filter.find(name) != std::string::npos;
+    }
+
+
+    // opsPerCall is the number of primitive operations done by one call of fn, results are reported per operation.
+    template<typename F>
+    void run(const char *name, const char *variant, uint64_t iterations, F &&fn, uint64_t opsPerCall = 1)
+    {
+        if (!filter.empty() && (std::string(name) + "/" + variant).find(filter) == std::string::npos) {
+            return;
+        }
+
+        iterations = std::max<uint64_t>(1, static_cast<uint64_t>(iterations * scale));
+
+        for (uint64_t i = 0, warmup = std::max<uint64_t>(1, iterations / 10); i < warmup; ++i) {
+            fn(i);
+        }
+
+        itlb.start();
+
+        const uint64_t ts     = steadyNSecs();
+        const uint64_t cycles = readTSC();
+
+        for (uint64_t i = 0; i < iterations; ++i) {
+            fn(i);
+        }
+
+        const uint64_t elapsedCycles = readTSC() - cycles;
+        const uint64_t elapsedNs     = steadyNSecs() - ts;
+
+        BenchResult result = { name, variant, iterations * opsPerCall, elapsedCycles, elapsedNs, itlb.stop() };
+        results.push_back(result);
+
+        char misses[16] = "-";
+        if (result.itlbMisses >= 0) {
+            snprintf(misses, sizeof(misses), "%.3f", static_cast<double>(result.itlbMisses) / result.iterations);
+        }
+
+        printf("%-24s %-10s %10" PRIu64 " %14.1f %12.1f %10s\n", name, variant, result.iterations, static_cast<double>(result.cycles) / result.iterations, static_cast<double>(result.ns) / result.iterations, misses);
+        fflush(stdout);
+    }
+
+
+    rapidjson::Document toJSON(const Algorithm &algorithm, int64_t cpu) const
+    {
+        using namespace rapidjson;
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        uint64_t cycles = 0;
+        uint64_t ns     = 0;
+
+        Value list(kArrayType);
+        for (const auto &result : results) {
+            Value out(kObjectType);
+            out.AddMember("name",           StringRef(result.name.c_str()), allocator);
+            out.AddMember("variant",        StringRef(result.variant.c_str()), allocator);
+            out.AddMember("iterations",     result.iterations, allocator);
+            out.AddMember("cycles_per_op",  Json::normalize(static_cast<double>(result.cycles) / result.iterations, false), allocator);
+            out.AddMember("ns_per_op",      Json::normalize(static_cast<double>(result.ns) / result.iterations, false), allocator);
+            out.AddMember("ops_per_sec",    Json::normalize(result.iterations * 1e9 / std::max<uint64_t>(result.ns, 1), false), allocator);
+
+            if (result.itlbMisses >= 0) {
+                out.AddMember("itlb_misses_per_op", Json::normalize(static_cast<double>(result.itlbMisses) / result.iterations, false), allocator);
+            }
+            else {
+                out.AddMember("itlb_misses_per_op", Value(kNullType), allocator);
+            }
+
+            list.PushBack(out, allocator);
+
+            cycles += result.cycles;
+            ns     += result.ns;
+        }
+
+        doc.AddMember("algo",       StringRef(algorithm.shortName()), allocator);
+        doc.AddMember("cpu",        StringRef(Cpu::info()->brand()), allocator);
+        doc.AddMember("affinity",   cpu, allocator);
+        doc.AddMember("tsc",        readTSC() != 0, allocator);
+        doc.AddMember("tsc_ghz",    Json::normalize(ns ? static_cast<double>(cycles) / ns : 0.0, false), allocator);
+        doc.AddMember("results",    list, allocator);
+
+        return doc;
+    }
+};
+
+
+static const char *arg(int argc, char **argv, const char *name)
+{
+    for (int i = 1; i < argc - 1; ++i) {
+        if (strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+
+    return nullptr;
+}
+
+
+static bool hasArg(int argc, char **argv, const char *name)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static void benchAes(Bench &bench, uint8_t *scratchpad)
+{
+    const size_t size = RandomX_CurrentConfig.ScratchpadL3_Size;
+    const bool hardAes = Cpu::info()->hasAES();
+    alignas(64) uint8_t hash[64] = {};
+    alignas(64) uint8_t state[64] = {};
+    alignas(64) randomx::Program program;
+
+    // The hard variants use AES-NI unconditionally, they are skipped on CPUs without it.
+    if (hardAes) {
+        bench.run("hashAes1Rx4", "hard", 400, [&](uint64_t) { hashAes1Rx4<false>(scratchpad, size, hash); });
+    }
+    bench.run("hashAes1Rx4", "soft", 100, [&](uint64_t) { hashAes1Rx4<true>(scratchpad, size, hash); });
+
+    if (hardAes) {
+        bench.run("fillAes1Rx4", "hard", 400, [&](uint64_t) { fillAes1Rx4<false>(state, size, scratchpad); });
+    }
+    bench.run("fillAes1Rx4", "soft", 100, [&](uint64_t) { fillAes1Rx4<true>(state, size, scratchpad); });
+
+    if (hardAes) {
+        bench.run("fillAes4Rx4", "hard", 200000, [&](uint64_t) { fillAes4Rx4<false>(hash, sizeof(program), &program); });
+    }
+    bench.run("fillAes4Rx4", "soft", 50000,  [&](uint64_t) { fillAes4Rx4<true>(hash, sizeof(program), &program); });
+
+    if (hardAes) {
+        bench.run("hashAndFillAes1Rx4", "hard", 400, [&](uint64_t) { hashAndFillAes1Rx4<0, 2>(scratchpad, size, hash, state); });
+    }
+    bench.run("hashAndFillAes1Rx4", "soft",   100, [&](uint64_t) { hashAndFillAes1Rx4<1, 1>(scratchpad, size, hash, state); });
+    bench.run("hashAndFillAes1Rx4", "soft2x1", 100, [&](uint64_t) { hashAndFillAes1Rx4<2, 1>(scratchpad, size, hash, state); });
+    bench.run("hashAndFillAes1Rx4", "soft2x2", 100, [&](uint64_t) { hashAndFillAes1Rx4<2, 2>(scratchpad, size, hash, state); });
+    bench.run("hashAndFillAes1Rx4", "soft2x4", 100, [&](uint64_t) { hashAndFillAes1Rx4<2, 4>(scratchpad, size, hash, state); });
+}
+
+
+static void benchHashes(Bench &bench)
+{
+    alignas(64) uint8_t in[76] = {};
+    alignas(64) uint8_t out[64] = {};
+    alignas(64) uint8_t k12[32] = {};
+
+    rx_blake2b_use_sse41 = 0;
+    bench.run("rx_blake2b", "generic", 200000, [&](uint64_t i) { in[39] = static_cast<uint8_t>(i); rx_blake2b(out, sizeof(out), in, sizeof(in)); });
+
+#   if defined(XMRIG_FEATURE_SSE4_1)
+    if (Cpu::info()->has(ICpuInfo::FLAG_SSE41)) {
+        rx_blake2b_use_sse41 = 1;
+        bench.run("rx_blake2b", "sse41", 200000, [&](uint64_t i) { in[39] = static_cast<uint8_t>(i); rx_blake2b(out, sizeof(out), in, sizeof(in)); });
+    }
+#   endif
+
+    yespower_params_t params = { YESPOWER_1_0, 2048, 8, nullptr };
+    bench.run("yespower", "2048x8", 400, [&](uint64_t i) { out[0] = static_cast<uint8_t>(i); yespower_tls(out, sizeof(out), &params, reinterpret_cast<yespower_binary_t *>(out)); });
+
+    VirtualMemory memory(yespower_local_size(&params), false, false, false);
+    bench.run("yespower", "2048x8-fix", 400, [&](uint64_t i) { out[0] = static_cast<uint8_t>(i); yespower_1_0_2048_8(memory.raw(), out, sizeof(out), reinterpret_cast<yespower_binary_t *>(out)); });
+
+    bench.run("KangarooTwelve", "64to32", 200000, [&](uint64_t i) { out[0] = static_cast<uint8_t>(i); KangarooTwelve(out, sizeof(out), k12, sizeof(k12), nullptr, 0); });
+}
+
+
+// The specialised yespower must match the generic one, including inputs longer than a SHA-256 block.
+static bool checkYespower()
+{
+    yespower_params_t params = { YESPOWER_1_0, 2048, 8, nullptr };
+    VirtualMemory memory(yespower_local_size(&params), false, false, false);
+    alignas(64) uint8_t in[160] = {};
+
+    for (size_t i = 0; i < 64; ++i) {
+        const size_t size = (i * 37) % sizeof(in);
+        in[i % sizeof(in)] ^= static_cast<uint8_t>(i * 131 + 1);
+
+        yespower_binary_t expected;
+        yespower_binary_t result;
+        yespower_tls(in, size, &params, &expected);
+        yespower_1_0_2048_8(memory.raw(), in, size, &result);
+
+        if (memcmp(&expected, &result, sizeof(result)) != 0) {
+            fprintf(stderr, "yespower 2048x8 specialised hash mismatch, input size %zu\n", size);
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static void benchJit(Bench &bench)
+{
+    alignas(64) uint8_t seed[64] = {};
+    alignas(64) randomx::Program program;
+    randomx::ProgramConfiguration config = {};
+
+    // Only the generated program matters here, the soft fill works on every CPU.
+    fillAes4Rx4<true>(seed, sizeof(program), &program);
+
+    static const char *profiles[] = { "auto", "generic", "intel", "zen" };
+
+    for (int profile = 0; profile < 4; ++profile) {
+        randomx_set_jit_profile(profile);
+
+        randomx::JitCompiler jit(false, false);
+        bench.run("JIT generateProgram", profiles[profile], 100000, [&](uint64_t) { jit.generateProgram(program, config, 0); });
+    }
+
+    randomx_set_jit_profile(0);
+}
+
+
+static void benchSuperscalar(Bench &bench, randomx_cache *cache)
+{
+    randomx::SuperscalarProgram program;
+    randomx::int_reg_t r[8] = {};
+    const char key[] = "xlarig-bench";
+
+    bench.run("SuperscalarHash", "generate", 2000, [&](uint64_t i) {
+        randomx::Blake2Generator gen(key, sizeof(key), static_cast<int>(i));
+        randomx::generateSuperscalar(program, gen);
+    });
+
+    bench.run("SuperscalarHash", "execute", 200000, [&](uint64_t) { randomx::executeSuperscalar(r, cache->programs[0]); });
+
+    alignas(64) uint8_t item[randomx::CacheLineSize];
+    bench.run("initDatasetItem", "interp", 50000, [&](uint64_t i) { randomx::initDatasetItem(cache, item, i); });
+}
+
+
+static void benchDatasetInit(Bench &bench, const char *variant, randomx_cache *cache, uint8_t *memory, uint32_t items)
+{
+    randomx_dataset *dataset = randomx_create_dataset(memory);
+
+    bench.run("initDatasetItem", variant, 50, [&](uint64_t) { randomx_init_dataset(dataset, cache, 0, items); }, items);
+
+    randomx_release_dataset(dataset);
+}
+
+
+// Full hashes on a fresh VM, the program of every hash is compiled with the current JIT settings.
+static void benchFullHash(Bench &bench, const char *name, const char *variant, const Algorithm &algorithm, randomx_dataset *dataset, uint8_t *scratchpad)
+{
+    const int flags = RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_JIT | (Cpu::info()->hasAES() ? RANDOMX_FLAG_HARD_AES : 0);
+    alignas(64) uint8_t blob[76] = {};
+    alignas(64) uint8_t hash[RANDOMX_HASH_SIZE];
+
+    randomx_vm *vm = randomx_create_vm(static_cast<randomx_flags>(flags), nullptr, dataset, scratchpad, 0);
+    bench.run(name, variant, 400, [&](uint64_t i) {
+        memcpy(blob + 39, &i, sizeof(uint32_t));
+        randomx_calculate_hash(vm, blob, sizeof(blob), hash, algorithm);
+    });
+
+    randomx_destroy_vm(vm);
+}
+
+
+static void benchDatasetPrefetch(Bench &bench, const Algorithm &algorithm, randomx_dataset *dataset, uint8_t *scratchpad)
+{
+    static const char *modes[] = { "auto", "off", "t0", "nta", "t1", "t2" };
+
+    for (int mode = -1; mode <= 4; ++mode) {
+        randomx_set_dataset_prefetch_mode(mode);
+        RxAlgo::apply(algorithm);
+
+        benchFullHash(bench, "dataset_prefetch", modes[mode + 1], algorithm, dataset, scratchpad);
+    }
+
+    randomx_set_dataset_prefetch_mode(-1);
+    RxAlgo::apply(algorithm);
+}
+
+
+// Execution time of the program with each code layout profile, "JIT generateProgram" above only times the emission.
+static void benchJitProfiles(Bench &bench, const Algorithm &algorithm, randomx_dataset *dataset, uint8_t *scratchpad)
+{
+    static const char *profiles[] = { "auto", "generic", "intel", "zen" };
+
+    for (int profile = 0; profile < 4; ++profile) {
+        randomx_set_jit_profile(profile);
+
+        benchFullHash(bench, "jit_profile", profiles[profile], algorithm, dataset, scratchpad);
+    }
+
+    randomx_set_jit_profile(0);
+}
+
+
+// Hashes round robin on several VMs, as the threads of a core or a CCX run them, with each VM in its own mapping
+// or with the prologue, epilogue and SuperscalarHash code shared; "itlb/op" shows the instruction TLB pressure.
+static void benchJitSharing(Bench &bench, const Algorithm &algorithm, randomx_cache *cache, randomx_dataset *dataset, uint8_t *scratchpad, size_t count)
+{
+    static const char *variants[2][2] = { { "lt-private", "lt-shared" }, { "private", "shared" } };
+
+    const int flags = RANDOMX_FLAG_JIT | (Cpu::info()->hasAES() ? RANDOMX_FLAG_HARD_AES : 0);
+    alignas(64) uint8_t blob[76] = {};
+    alignas(64) uint8_t hash[RANDOMX_HASH_SIZE];
+
+    for (int full = 0; full < 2; ++full) {
+        if (full && !dataset) {
+            break;
+        }
+
+        for (int shared = 0; shared < 2; ++shared) {
+            randomx_set_shared_jit_code(shared != 0);
+
+            std::vector<randomx_vm *> vms;
+            for (size_t i = 0; i < count; ++i) {
+                randomx_vm *vm = full ? randomx_create_vm(static_cast<randomx_flags>(flags | RANDOMX_FLAG_FULL_MEM), nullptr, dataset, scratchpad, 0)
+                                      : randomx_create_vm(static_cast<randomx_flags>(flags), cache, nullptr, scratchpad, 0);
+                if (vm) {
+                    vms.push_back(vm);
+                }
+            }
+
+            if (!vms.empty()) {
+                bench.run("jit_sharing", variants[full][shared], full ? 400 : 40, [&](uint64_t i) {
+                    memcpy(blob + 39, &i, sizeof(uint32_t));
+                    randomx_calculate_hash(vms[i % vms.size()], blob, sizeof(blob), hash, algorithm);
+                });
+            }
+
+            for (randomx_vm *vm : vms) {
+                randomx_destroy_vm(vm);
+            }
+        }
+    }
+
+    randomx_set_shared_jit_code(true);
+}
+
+
+} // namespace xmrig
+
+
+int main(int argc, char **argv)
+{
+    using namespace xmrig;
+
+    const Algorithm algorithm(arg(argc, argv, "--algo") ? arg(argc, argv, "--algo") : "panthera");
+    if (algorithm.family() != Algorithm::RANDOM_X) {
+        fprintf(stderr, "unsupported algorithm\n");
+
+        return 1;
+    }
+
+    Bench bench;
+    bench.filter = arg(argc, argv, "--filter") ? arg(argc, argv, "--filter") : "";
+    bench.scale  = arg(argc, argv, "--scale") ? atof(arg(argc, argv, "--scale")) : 1.0;
+
+    const auto &units = Cpu::info()->units();
+    const int64_t cpu = arg(argc, argv, "--cpu") ? strtoll(arg(argc, argv, "--cpu"), nullptr, 10) : (units.empty() ? -1 : units.front());
+    Platform::trySetThreadAffinity(cpu);
+
+    RxAlgo::apply(algorithm);
+    randomx_set_optimized_dataset_init(0);
+
+    printf("%s, %s, cpu %" PRId64 "\n\n", algorithm.shortName(), Cpu::info()->brand(), cpu);
+    printf("%-24s %-10s %10s %14s %12s %10s\n", "name", "variant", "iterations", "cycles/op", "ns/op", "itlb/op");
+
+    VirtualMemory scratchpad(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, false, false, false);
+    memset(scratchpad.scratchpad(), 0x5A, RANDOMX_SCRATCHPAD_L3_MAX_SIZE);
+
+    if (!checkYespower()) {
+        return 1;
+    }
+
+    benchAes(bench, scratchpad.scratchpad());
+    benchHashes(bench);
+    benchJit(bench);
+
+    const char key[]         = "xlarig-bench";
+    const uint32_t items     = 10000;
+    VirtualMemory cacheMemory(RANDOMX_CACHE_MAX_SIZE, false, false, false);
+    VirtualMemory datasetMemory(items * randomx::CacheLineSize, false, false, false);
+
+    randomx_cache *cache = randomx_create_cache(RANDOMX_FLAG_JIT, cacheMemory.raw());
+    if (!cache) {
+        cache = randomx_create_cache(RANDOMX_FLAG_DEFAULT, cacheMemory.raw());
+    }
+
+    randomx_init_cache(cache, key, sizeof(key));
+
+    benchSuperscalar(bench, cache);
+    benchDatasetInit(bench, cache->jit ? "jit" : "cache", cache, datasetMemory.raw(), items);
+
+    // Full hashes need the dataset, it is built only if it's small (Panthera) or --dataset is given.
+    const bool fullHash = bench.wants("dataset_prefetch") || bench.wants("jit_profile") || bench.wants("jit_sharing");
+    const size_t datasetSize = randomx_dataset_item_count() * randomx::CacheLineSize;
+    const size_t vms = arg(argc, argv, "--vms") ? std::max<size_t>(1, strtoul(arg(argc, argv, "--vms"), nullptr, 10)) : 16;
+
+    if (cache->jit && fullHash && (datasetSize <= 256U * 1024U * 1024U || hasArg(argc, argv, "--dataset"))) {
+        VirtualMemory memory(datasetSize, true, false, false);
+        randomx_dataset *dataset = randomx_create_dataset(memory.raw());
+        randomx_init_dataset(dataset, cache, 0, randomx_dataset_item_count());
+
+        benchDatasetPrefetch(bench, algorithm, dataset, scratchpad.scratchpad());
+        benchJitProfiles(bench, algorithm, dataset, scratchpad.scratchpad());
+        benchJitSharing(bench, algorithm, cache, dataset, scratchpad.scratchpad(), vms);
+
+        randomx_release_dataset(dataset);
+    }
+    else if (cache->jit && bench.wants("jit_sharing")) {
+        benchJitSharing(bench, algorithm, cache, nullptr, scratchpad.scratchpad(), vms);
+    }
+
+    randomx_release_cache(cache);
+
+    // The AVX2 dataset init code is generated for the reference superscalar parameters, Panthera uses its own.
+    if (algorithm != Algorithm::RX_XLA && Cpu::info()->hasAVX2()) {
+        randomx_set_optimized_dataset_init(1);
+
+        cache = randomx_create_cache(RANDOMX_FLAG_JIT, cacheMemory.raw());
+        if (cache) {
+            randomx_init_cache(cache, key, sizeof(key));
+            benchDatasetInit(bench, "jit-avx2", cache, datasetMemory.raw(), items);
+            randomx_release_cache(cache);
+        }
+
+        randomx_set_optimized_dataset_init(0);
+    }
+
+    const auto doc = bench.toJSON(algorithm, cpu);
+    const char *fileName = arg(argc, argv, "--json");
+
+    if (fileName && strcmp(fileName, "-") != 0) {
+        if (!Json::save(fileName, doc)) {
+            fprintf(stderr, "failed to save \"%s\"\n", fileName);
+
+            return 1;
+        }
+    }
+    else if (fileName) {
+        rapidjson::StringBuffer buffer(nullptr, 4096);
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+        doc.Accept(writer);
+
+        printf("\n%s\n", buffer.GetString());
+    }
+
+    return 0;
+}
@@ -24,6 +24,7 @@
 
 
 #include <algorithm>
+#include <deque>
 #include <mutex>
 #include <thread>
 
@@ -37,11 +38,15 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/net/stratum/Job.h"
+#include "base/net/stratum/Pools.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Object.h"
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "core/PressureGovernor.h"
 #include "crypto/common/Nonce.h"
+#include "net/JobResult.h"
 #include "version.h"
 
 
@@ -135,6 +140,10 @@ public:
         }
 
         if (reset) {
+            if (job.index() == 0) {
+                saveBacklog(Nonce::counter(0));
+            }
+
             Nonce::reset(job.index());
         }
 
@@ -155,6 +164,52 @@ public:
     }
 
 
+    // Jobs of the same pool session and block stay valid after a new one arrives, the unused part of their nonce range is kept for later.
+    inline bool isBacklogCompatible(const Job &other) const
+    {
+        return other.index() == 0 && other.height() > 0 && other.id() != job.id() && other.clientId() == job.clientId()
+               && other.height() == job.height() && other.algorithm() == job.algorithm() && other.seed() == job.seed();
+    }
+
+
+    void saveBacklog(uint64_t counter)
+    {
+        backlog.erase(std::remove_if(backlog.begin(), backlog.end(), [this](const std::pair<Job, uint64_t> &item) { return !isBacklogCompatible(item.first); }), backlog.end());
+
+        if (isBacklogCompatible(previous) && counter < (previous.nonceMask() & 0x7FFFFFFFFFFFFFFFULL)) {
+            backlog.emplace_front(previous, counter);
+        }
+
+        while (backlog.size() > controller->config()->jobBacklog()) {
+            backlog.pop_back();
+        }
+
+        previous = Job();
+    }
+
+
+    // Workers continue with the most recent backlog job instead of waiting for a new one from the pool.
+    void resumeBacklog()
+    {
+        auto item = std::move(backlog.front());
+        backlog.pop_front();
+
+        LOG_INFO("%s " YELLOW("nonce range exhausted") ", resume job " WHITE_BOLD("%s") BLACK_BOLD(" (%zu left)"), Tags::miner(), item.first.id().data(), backlog.size());
+
+        mutex.lock();
+
+        job       = std::move(item.first);
+        userJobId = job.id();
+
+        mutex.unlock();
+
+        reset = false;
+        Nonce::reset(job.index(), item.second);
+
+        handleJobChange();
+    }
+
+
 #   ifdef XMRIG_FEATURE_API
     void getMiner(rapidjson::Value &reply, rapidjson::Document &doc, int) const
     {
@@ -175,6 +230,7 @@ public:
         }
 
         reply.AddMember("algorithms", algo, allocator);
+        reply.AddMember("pressure",   pressure.toJSON(doc), allocator);
     }
 
 
@@ -345,6 +401,19 @@ public:
 
 #   ifdef XMRIG_ALGO_RANDOMX
     inline bool initRX() { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
+
+
+    // Weighted pools: workers start only when the dataset of every RandomX partition is ready.
+    bool isPartitionsReady() const
+    {
+        for (const Job &item : partitions) {
+            if (item.isValid() && item.algorithm().family() == Algorithm::RANDOM_X && !Rx::isReady(item)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
 #   endif
 
 
@@ -358,8 +427,13 @@ public:
     bool reset          = true;
     Controller *controller;
     Job job;
+    Job previous;
     mutable std::map<Algorithm::Id, double> maxHashrate;
+    PressureGovernor pressure;
+    std::deque<std::pair<Job, uint64_t> > backlog;
     std::vector<IBackend *> backends;
+    std::vector<Algorithm> layout;
+    std::vector<Job> partitions;
     String userJobId;
     Timer *timer        = nullptr;
     uint64_t ticks      = 0;
@@ -420,6 +494,29 @@ xmrig::Miner::~Miner()
 }
 
 
+// Called with the result a worker sends when the nonce range of its job has run out. Returns true if the miner moved on
+// to a backlog job, in that case the pool connection doesn't need to be renewed to get fresh work.
+bool xmrig::Miner::resumeBacklog(const JobResult &result)
+{
+    if (d_ptr->controller->config()->jobBacklog() == 0 || result.index != 0 || result.clientId != d_ptr->job.clientId()) {
+        return false;
+    }
+
+    // Other workers still report the job the miner has already moved away from.
+    if (result.jobId != d_ptr->job.id()) {
+        return true;
+    }
+
+    if (d_ptr->backlog.empty()) {
+        return false;
+    }
+
+    d_ptr->resumeBacklog();
+
+    return true;
+}
+
+
 bool xmrig::Miner::isEnabled() const
 {
     return d_ptr->enabled;
@@ -444,6 +541,22 @@ const std::vector<xmrig::IBackend *> &xmrig::Miner::backends() const
 }
 
 
+xmrig::Algorithms xmrig::Miner::partitionAlgorithms(size_t count) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Algorithms out(count, d_ptr->job.algorithm());
+
+    for (size_t i = 0; i < count && i < d_ptr->layout.size(); ++i) {
+        if (d_ptr->layout[i].isValid()) {
+            out[i] = d_ptr->layout[i];
+        }
+    }
+
+    return out;
+}
+
+
 xmrig::Job xmrig::Miner::job() const
 {
     std::lock_guard<std::mutex> lock(mutex);
@@ -452,6 +565,19 @@ xmrig::Job xmrig::Miner::job() const
 }
 
 
+// Job of one weighted pool partition, every partition mines the donate job while it is active.
+xmrig::Job xmrig::Miner::job(uint32_t partition) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (d_ptr->job.index() == 1 || partition >= d_ptr->partitions.size()) {
+        return d_ptr->job;
+    }
+
+    return d_ptr->partitions[partition];
+}
+
+
 void xmrig::Miner::execCommand(char command)
 {
     switch (command) {
@@ -550,11 +676,18 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
     const uint8_t index = donate ? 1 : 0;
 
     d_ptr->reset = !(d_ptr->job.index() == 1 && index == 0 && d_ptr->userJobId == job.id());
+
+    if (index == 0 && d_ptr->reset && d_ptr->controller->config()->jobBacklog() > 0) {
+        d_ptr->previous = d_ptr->job;
+    }
+
     d_ptr->job   = job;
     d_ptr->job.setIndex(index);
 
     if (index == 0) {
         d_ptr->userJobId = job.id();
+        d_ptr->layout.clear();
+        d_ptr->partitions.clear();
     }
 
 #   ifdef XMRIG_ALGO_RANDOMX
@@ -573,6 +706,98 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
 }
 
 
+// Weighted pools: partition N mines with nonce counter 2 + N, an invalid job leaves its threads idle.
+void xmrig::Miner::setJob(const Job &job, uint32_t partition)
+{
+    static_assert(Pools::kMaxWeighted <= Nonce::kPartitions, "Not enough nonce counters for the weighted pools");
+
+    if (partition >= Nonce::kPartitions) {
+        return;
+    }
+
+    Job next(job);
+
+    mutex.lock();
+
+    if (d_ptr->partitions.size() <= partition) {
+        d_ptr->layout.resize(partition + 1);
+        d_ptr->partitions.resize(partition + 1);
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    // Workers of all partitions share one dataset, so only one RandomX variant can be mined at a time.
+    if (next.algorithm().family() == Algorithm::RANDOM_X) {
+        for (size_t i = 0; i < d_ptr->partitions.size(); ++i) {
+            const Algorithm &other = d_ptr->partitions[i].algorithm();
+
+            if (i != partition && d_ptr->partitions[i].isValid() && other.family() == Algorithm::RANDOM_X && other != next.algorithm()) {
+                LOG_WARN("%s " YELLOW("pool #%u: %s can't be mined next to %s, skip job"), Tags::miner(), partition + 1, next.algorithm().shortName(), other.shortName());
+                next = Job();
+                break;
+            }
+        }
+    }
+#   endif
+
+    // The same job replayed after a dev donate round keeps its nonce counter, like Miner::setJob(job, false) does.
+    if (next.isValid()) {
+        d_ptr->layout[partition] = next.algorithm();
+        next.setIndex(static_cast<uint8_t>(2 + partition));
+
+        if (next != d_ptr->partitions[partition]) {
+            Nonce::reset(next.index());
+        }
+    }
+
+    d_ptr->partitions[partition] = next;
+
+    Job primary;
+    for (const Job &item : d_ptr->partitions) {
+        if (item.isValid()) {
+            primary = item;
+            break;
+        }
+    }
+
+    mutex.unlock();
+
+    if (!primary.isValid()) {
+        return;
+    }
+
+    for (IBackend *backend : d_ptr->backends) {
+        backend->prepare(next.isValid() ? next : primary);
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (next.algorithm().family() == Algorithm::RANDOM_X && !Rx::isReady(next)) {
+        stop();
+    }
+#   endif
+
+    d_ptr->algorithm = primary.algorithm();
+
+    mutex.lock();
+
+    d_ptr->reset = false;
+    d_ptr->job   = primary;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    const bool ready = (next.algorithm().family() != Algorithm::RANDOM_X || Rx::init(next, d_ptr->controller->config()->rx(), d_ptr->controller->config()->cpu())) && d_ptr->isPartitionsReady();
+#   else
+    constexpr const bool ready = true;
+#   endif
+
+    mutex.unlock();
+
+    d_ptr->active = true;
+
+    if (ready) {
+        d_ptr->handleJobChange();
+    }
+}
+
+
 void xmrig::Miner::stop()
 {
     Nonce::stop();
@@ -628,6 +853,13 @@ void xmrig::Miner::onTimer(const Timer *)
         d_ptr->printHashrate(false);
     }
 
+    // The governor only sheds CPU workers, GPU backends are not affected.
+    if ((d_ptr->ticks % 2) == 0) {
+        const IBackend *cpu = d_ptr->backends.front();
+
+        d_ptr->pressure.tick(config->pressure(), cpu->isEnabled() && cpu->hashrate() ? cpu->hashrate()->threads() : 0, Chrono::steadyMSecs());
+    }
+
     d_ptr->ticks++;
 
     auto autoPause = [this](bool &state, bool pause, const char *pauseMessage, const char *activeMessage)
@@ -699,7 +931,7 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 #ifdef XMRIG_ALGO_RANDOMX
 void xmrig::Miner::onDatasetReady()
 {
-    if (!Rx::isReady(job())) {
+    if (d_ptr->partitions.empty() ? !Rx::isReady(job()) : !d_ptr->isPartitionsReady()) {
         return;
     }
 
@@ -42,6 +42,7 @@ namespace xmrig {
 
 class Controller;
 class Job;
+class JobResult;
 class MinerPrivate;
 class IBackend;
 
@@ -56,13 +57,17 @@ public:
 
     bool isEnabled() const;
     bool isEnabled(const Algorithm &algorithm) const;
+    bool resumeBacklog(const JobResult &result);
     const Algorithms &algorithms() const;
     const std::vector<IBackend *> &backends() const;
+    Algorithms partitionAlgorithms(size_t count) const;
     Job job() const;
+    Job job(uint32_t partition) const;
     void execCommand(char command);
     void pause();
     void setEnabled(bool enabled);
     void setJob(const Job &job, bool donate);
+    void setJob(const Job &job, uint32_t partition);
     void stop();
 
 protected:
@@ -0,0 +1,224 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "core/PressureGovernor.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "core/config/PressureConfig.h"
+#include "crypto/common/Nonce.h"
+
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+
+namespace xmrig {
+
+
+static const char *kResources[PressureGovernor::MAX] = { "cpu", "memory", "io" };
+
+
+// The "some avg10" value: the share of the last 10 seconds in which at least one task was stalled on the resource.
+static bool readSome(const std::string &path, double &value)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (sscanf(line.c_str(), "some avg10=%lf", &value) == 1) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::PressureGovernor::~PressureGovernor()
+{
+    release();
+}
+
+
+// Called once per second.  A thread is shed while any pressure is over its target and restored once all of them are under
+// restore * target, with at least "interval" seconds between changes so the 10 seconds average can follow.
+void xmrig::PressureGovernor::tick(const PressureConfig &config, size_t threads, uint64_t now)
+{
+    if (!config.isEnabled() || threads == 0) {
+        release();
+
+        return;
+    }
+
+    const auto count = static_cast<uint32_t>(threads);
+
+    if (!m_enabled || count != m_threads) {
+        m_active  = (!m_enabled || m_active >= m_threads) ? count : std::min(m_active, count);
+        m_threads = count;
+        m_enabled = true;
+        m_changed = now;
+
+        Nonce::setThreads(m_active < m_threads ? m_active : UINT32_MAX);
+    }
+
+    m_restore   = config.restore();
+    m_available = read(config);
+    if (!m_available) {
+        if (!m_warned) {
+            LOG_WARN("%s " YELLOW_BOLD("pressure stall information is not available, threads are not governed"), Tags::miner());
+            m_warned = true;
+        }
+
+        return;
+    }
+
+    if (now - m_changed < config.interval() * 1000ULL) {
+        return;
+    }
+
+    const uint32_t minThreads = std::min(config.minThreads(), m_threads);
+
+    if (m_ratio > 1.0 && m_active > minThreads) {
+        setActive(m_active - 1, now);
+    }
+    else if (m_ratio < m_restore && m_active < m_threads) {
+        setActive(m_active + 1, now);
+    }
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::PressureGovernor::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("enabled",    m_enabled, allocator);
+
+    if (!m_enabled) {
+        return out;
+    }
+
+    out.AddMember("available",  m_available, allocator);
+    out.AddMember("state",      StringRef(m_active < m_threads ? "shed" : "full"), allocator);
+    out.AddMember("threads",    m_threads, allocator);
+    out.AddMember("active",     m_active, allocator);
+    out.AddMember("ratio",      m_ratio, allocator);
+    out.AddMember("shed",       m_shed, allocator);
+    out.AddMember("restored",   m_restored, allocator);
+
+    for (uint32_t i = 0; i < MAX; ++i) {
+        if (m_target[i] <= 0.0) {
+            continue;
+        }
+
+        Value resource(kObjectType);
+        resource.AddMember("avg10",     m_pressure[i], allocator);
+        resource.AddMember("target",    m_target[i], allocator);
+
+        out.AddMember(StringRef(kResources[i]), resource, allocator);
+    }
+
+    return out;
+}
+#endif
+
+
+bool xmrig::PressureGovernor::read(const PressureConfig &config)
+{
+    const double targets[MAX] = { config.cpu(), config.memory(), config.io() };
+    bool available = false;
+
+    m_ratio = 0.0;
+
+    for (uint32_t i = 0; i < MAX; ++i) {
+        m_target[i]   = targets[i];
+        m_pressure[i] = 0.0;
+
+        if (targets[i] <= 0.0) {
+            continue;
+        }
+
+        // A cgroup directory has its own cpu.pressure, memory.pressure and io.pressure (cgroup v2 only).
+        const std::string path = config.cgroup().isEmpty() ? (std::string("/proc/pressure/") + kResources[i])
+                                                           : (std::string(config.cgroup().data()) + "/" + kResources[i] + ".pressure");
+
+        if (readSome(path, m_pressure[i])) {
+            available = true;
+            m_ratio   = std::max(m_ratio, m_pressure[i] / targets[i]);
+        }
+    }
+
+    return available;
+}
+
+
+void xmrig::PressureGovernor::release()
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    if (m_active < m_threads) {
+        LOG_INFO("%s " GREEN_BOLD("pressure governor disabled, all %u threads active"), Tags::miner(), m_threads);
+    }
+
+    Nonce::setThreads(UINT32_MAX);
+
+    m_enabled = false;
+    m_active  = m_threads;
+}
+
+
+void xmrig::PressureGovernor::setActive(uint32_t active, uint64_t now)
+{
+    uint32_t resource = CPU;
+    for (uint32_t i = 1; i < MAX; ++i) {
+        if (m_target[i] > 0.0 && (m_target[resource] <= 0.0 || m_pressure[i] / m_target[i] > m_pressure[resource] / m_target[resource])) {
+            resource = i;
+        }
+    }
+
+    if (active < m_active) {
+        ++m_shed;
+
+        LOG_INFO("%s " YELLOW_BOLD("%s pressure %.1f%% > %.1f%%") ", shed thread " CYAN_BOLD("#%u") BLACK_BOLD(" (%u/%u active)"),
+                 Tags::miner(), kResources[resource], m_pressure[resource], m_target[resource], active, active, m_threads);
+    }
+    else {
+        ++m_restored;
+
+        LOG_INFO("%s " GREEN_BOLD("%s pressure %.1f%% < %.1f%%") ", restore thread " CYAN_BOLD("#%u") BLACK_BOLD(" (%u/%u active)"),
+                 Tags::miner(), kResources[resource], m_pressure[resource], m_target[resource] * m_restore, m_active, active, m_threads);
+    }
+
+    m_active  = active;
+    m_changed = now;
+
+    Nonce::setThreads(m_active < m_threads ? m_active : UINT32_MAX);
+}
@@ -0,0 +1,83 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PRESSUREGOVERNOR_H
+#define XMRIG_PRESSUREGOVERNOR_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class PressureConfig;
+
+
+// Sheds and restores CPU workers one by one to keep the Linux pressure stall information (PSI) under the configured targets.
+class PressureGovernor
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(PressureGovernor)
+
+    enum Resource : uint32_t {
+        CPU,
+        MEMORY,
+        IO,
+        MAX
+    };
+
+    PressureGovernor() = default;
+    ~PressureGovernor();
+
+    void tick(const PressureConfig &config, size_t threads, uint64_t now);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#   endif
+
+private:
+    bool read(const PressureConfig &config);
+    void release();
+    void setActive(uint32_t active, uint64_t now);
+
+    bool m_available        = false;
+    bool m_enabled          = false;
+    bool m_warned           = false;
+    double m_pressure[MAX]  = {};
+    double m_ratio          = 0.0;
+    double m_restore        = 0.0;
+    double m_target[MAX]    = {};
+    uint32_t m_active       = 0;
+    uint32_t m_threads      = 0;
+    uint64_t m_changed      = 0;
+    uint64_t m_shed         = 0;
+    uint64_t m_restored     = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PRESSUREGOVERNOR_H */
@@ -28,6 +28,7 @@
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
+#include "core/config/PressureConfig.h"
 #include "crypto/common/Assembly.h"
 
 
@@ -54,6 +55,7 @@ constexpr static uint32_t kIdleTime     = 60U;
 
 const char *Config::kPauseOnBattery     = "pause-on-battery";
 const char *Config::kPauseOnActive      = "pause-on-active";
+const char *Config::kJobBacklog         = "job-backlog";
 
 
 #ifdef XMRIG_FEATURE_OPENCL
@@ -78,7 +80,9 @@ class ConfigPrivate
 public:
     bool pauseOnBattery = false;
     CpuConfig cpu;
+    PressureConfig pressure;
     uint32_t idleTime   = 0;
+    uint32_t jobBacklog = 0;
 
 #   ifdef XMRIG_ALGO_RANDOMX
     RxConfig rx;
@@ -138,12 +142,24 @@ const xmrig::CpuConfig &xmrig::Config::cpu() const
 }
 
 
+const xmrig::PressureConfig &xmrig::Config::pressure() const
+{
+    return d_ptr->pressure;
+}
+
+
 uint32_t xmrig::Config::idleTime() const
 {
     return d_ptr->idleTime * 1000U;
 }
 
 
+uint32_t xmrig::Config::jobBacklog() const
+{
+    return d_ptr->jobBacklog;
+}
+
+
 #ifdef XMRIG_FEATURE_OPENCL
 const xmrig::OclConfig &xmrig::Config::cl() const
 {
@@ -214,8 +230,10 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
 
     d_ptr->pauseOnBattery = reader.getBool(kPauseOnBattery, d_ptr->pauseOnBattery);
     d_ptr->setIdleTime(reader.getValue(kPauseOnActive));
+    d_ptr->jobBacklog     = reader.getUint(kJobBacklog, d_ptr->jobBacklog);
 
     d_ptr->cpu.read(reader.getValue(CpuConfig::kField));
+    d_ptr->pressure.read(reader.getValue(PressureConfig::kField));
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (!d_ptr->rx.read(reader.getValue(RxConfig::kField))) {
@@ -259,7 +277,7 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(kHttp),                     m_http.toJSON(doc), allocator);
     doc.AddMember(StringRef(kAutosave),                 isAutoSave(), allocator);
     doc.AddMember(StringRef(kBackground),               isBackground(), allocator);
-    doc.AddMember(StringRef(kColors),                   Log::isColors(), allocator);
+    doc.AddMember(StringRef(kColors),                   isColors(), allocator);
     doc.AddMember(StringRef(kTitle),                    title().toJSON(), allocator);
 
 #   ifdef XMRIG_ALGO_RANDOMX
@@ -296,8 +314,10 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 #   endif
 
     doc.AddMember(StringRef(kUserAgent),                m_userAgent.toJSON(), allocator);
-    doc.AddMember(StringRef(kVerbose),                  Log::verbose(), allocator);
+    doc.AddMember(StringRef(kVerbose),                  verbose(), allocator);
     doc.AddMember(StringRef(kWatch),                    m_watch, allocator);
     doc.AddMember(StringRef(kPauseOnBattery),           isPauseOnBattery(), allocator);
     doc.AddMember(StringRef(kPauseOnActive),            (d_ptr->idleTime == 0U || d_ptr->idleTime == kIdleTime) ? Value(isPauseOnActive()) : Value(d_ptr->idleTime), allocator);
+    doc.AddMember(StringRef(kJobBacklog),               jobBacklog(), allocator);
+    doc.AddMember(StringRef(PressureConfig::kField),    pressure().toJSON(doc), allocator);
 }
@@ -36,6 +36,7 @@ class ConfigPrivate;
 class CudaConfig;
 class IThread;
 class OclConfig;
+class PressureConfig;
 class RxConfig;
 
 
@@ -46,6 +47,7 @@ public:
 
     static const char *kPauseOnBattery;
     static const char *kPauseOnActive;
+    static const char *kJobBacklog;
 
 #   ifdef XMRIG_FEATURE_OPENCL
     static const char *kOcl;
@@ -70,7 +72,9 @@ public:
 
     bool isPauseOnBattery() const;
     const CpuConfig &cpu() const;
+    const PressureConfig &pressure() const;
     uint32_t idleTime() const;
+    uint32_t jobBacklog() const;
 
 #   ifdef XMRIG_FEATURE_OPENCL
     const OclConfig &cl() const;
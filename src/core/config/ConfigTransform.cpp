@@ -21,6 +21,8 @@
 #include "base/kernel/interfaces/IConfig.h"
 #include "base/net/stratum/Pool.h"
 #include "base/net/stratum/Pools.h"
+#include "base/net/stratum/replay/ReplayConfig.h"
+#include "core/config/PressureConfig.h"
 #include "core/config/Config.h"
 #include "crypto/cn/CnHash.h"
 
@@ -150,6 +152,21 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::PauseOnActiveKey: /* --pause-on-active */
         return set(doc, Config::kPauseOnActive, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
 
+    case IConfig::JobBacklogKey: /* --job-backlog */
+        return set(doc, Config::kJobBacklog, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
+    case IConfig::ReplayKey: /* --replay */
+        return set(doc, ReplayConfig::kField, ReplayConfig::kFile, arg);
+
+    case IConfig::ReplayReportKey: /* --replay-report */
+        return set(doc, ReplayConfig::kField, ReplayConfig::kReport, arg);
+
+    case IConfig::PressureKey: /* --pressure */
+        return set(doc, PressureConfig::kField, PressureConfig::kEnabled, true);
+
+    case IConfig::PressureCgroupKey: /* --pressure-cgroup */
+        return set(doc, PressureConfig::kField, PressureConfig::kCgroup, arg);
+
 #   ifdef XMRIG_ALGO_ARGON2
     case IConfig::Argon2ImplKey: /* --argon2-impl */
         return set(doc, CpuConfig::kField, CpuConfig::kArgon2Impl, arg);
@@ -53,7 +53,13 @@ R"===(
         "wrmsr": true,
         "cache_qos": false,
         "numa": true,
-        "scratchpad_prefetch_mode": 1
+        "l3_replicas": false,
+        "scratchpad_prefetch_mode": 1,
+        "dataset_prefetch_mode": -1,
+        "jit_profile": "auto",
+        "seed_cache": 1,
+        "seed_cache_memory": 0,
+        "shared_dataset": null
     },
     "cpu": {
         "enabled": true,
@@ -63,6 +69,8 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "smt-phase": false,
+        "warm-pools": 0,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
@@ -100,6 +108,8 @@ R"===(
             "rig-id": null,
             "nicehash": false,
             "keepalive": false,
+            "min-diff": 0,
+            "weight": 0,
             "enabled": true,
             "tls": false,
             "tls-fingerprint": null,
@@ -129,7 +139,18 @@ R"===(
     "verbose": 0,
     "watch": true,
     "pause-on-battery": false,
-    "pause-on-active": false
+    "pause-on-active": false,
+    "job-backlog": 0,
+    "pressure": {
+        "enabled": false,
+        "cpu": 20.0,
+        "memory": 10.0,
+        "io": 20.0,
+        "restore": 0.5,
+        "interval": 10,
+        "min-threads": 1,
+        "cgroup": null
+    }
 }
 )===";
 #endif
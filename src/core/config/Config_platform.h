@@ -52,6 +52,7 @@ static const option options[] = {
     { "daemon-poll-interval",  1, nullptr, IConfig::DaemonPollKey         },
     { "self-select",           1, nullptr, IConfig::SelfSelectKey         },
     { "submit-to-origin",      0, nullptr, IConfig::SubmitToOriginKey     },
+    { "min-diff",              1, nullptr, IConfig::MinDiffKey            },
 #   endif
     { "av",                    1, nullptr, IConfig::AVKey                 },
     { "background",            0, nullptr, IConfig::BackgroundKey         },
@@ -79,6 +80,7 @@ static const option options[] = {
     { "user-agent",            1, nullptr, IConfig::UserAgentKey          },
     { "userpass",              1, nullptr, IConfig::UserpassKey           },
     { "rig-id",                1, nullptr, IConfig::RigIdKey              },
+    { "weight",                1, nullptr, IConfig::WeightKey             },
     { "no-cpu",                0, nullptr, IConfig::CPUKey                },
     { "max-cpu-usage",         1, nullptr, IConfig::CPUMaxThreadsKey      },
     { "cpu-max-threads-hint",  1, nullptr, IConfig::CPUMaxThreadsKey      },
@@ -90,10 +92,18 @@ static const option options[] = {
     { "verbose",               0, nullptr, IConfig::VerboseKey            },
     { "proxy",                 1, nullptr, IConfig::ProxyKey              },
     { "data-dir",              1, nullptr, IConfig::DataDirKey            },
+#   ifdef XMRIG_FEATURE_HWLOC
+    { "topology-cache",        1, nullptr, IConfig::TopologyCacheKey      },
+#   endif
     { "title",                 1, nullptr, IConfig::TitleKey              },
     { "no-title",              0, nullptr, IConfig::NoTitleKey            },
     { "pause-on-battery",      0, nullptr, IConfig::PauseOnBatteryKey     },
     { "pause-on-active",       1, nullptr, IConfig::PauseOnActiveKey     },
+    { "job-backlog",           1, nullptr, IConfig::JobBacklogKey         },
+    { "replay",                1, nullptr, IConfig::ReplayKey             },
+    { "replay-report",         1, nullptr, IConfig::ReplayReportKey       },
+    { "pressure",              0, nullptr, IConfig::PressureKey           },
+    { "pressure-cgroup",       1, nullptr, IConfig::PressureCgroupKey     },
 #   ifdef XMRIG_FEATURE_BENCHMARK
     { "stress",                0, nullptr, IConfig::StressKey             },
     { "bench",                 1, nullptr, IConfig::BenchKey              },
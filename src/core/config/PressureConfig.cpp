@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "core/config/PressureConfig.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <algorithm>
+
+
+namespace xmrig {
+
+
+const char *PressureConfig::kCgroup     = "cgroup";
+const char *PressureConfig::kCpu        = "cpu";
+const char *PressureConfig::kEnabled    = "enabled";
+const char *PressureConfig::kField      = "pressure";
+const char *PressureConfig::kInterval   = "interval";
+const char *PressureConfig::kIo         = "io";
+const char *PressureConfig::kMemory     = "memory";
+const char *PressureConfig::kMinThreads = "min-threads";
+const char *PressureConfig::kRestore    = "restore";
+
+
+} // namespace xmrig
+
+
+rapidjson::Value xmrig::PressureConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember(StringRef(kEnabled),      m_enabled, allocator);
+    out.AddMember(StringRef(kCpu),          m_cpu, allocator);
+    out.AddMember(StringRef(kMemory),       m_memory, allocator);
+    out.AddMember(StringRef(kIo),           m_io, allocator);
+    out.AddMember(StringRef(kRestore),      m_restore, allocator);
+    out.AddMember(StringRef(kInterval),     m_interval, allocator);
+    out.AddMember(StringRef(kMinThreads),   m_minThreads, allocator);
+    out.AddMember(StringRef(kCgroup),       m_cgroup.toJSON(), allocator);
+
+    return out;
+}
+
+
+void xmrig::PressureConfig::read(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_enabled = value.GetBool();
+
+        return;
+    }
+
+    if (!value.IsObject()) {
+        return;
+    }
+
+    m_enabled       = Json::getBool(value, kEnabled, m_enabled);
+    m_cpu           = std::max(Json::getDouble(value, kCpu, m_cpu), 0.0);
+    m_memory        = std::max(Json::getDouble(value, kMemory, m_memory), 0.0);
+    m_io            = std::max(Json::getDouble(value, kIo, m_io), 0.0);
+    m_restore       = std::min(std::max(Json::getDouble(value, kRestore, m_restore), 0.0), 1.0);
+    m_interval      = std::max(Json::getUint(value, kInterval, m_interval), 1U);
+    m_minThreads    = Json::getUint(value, kMinThreads, m_minThreads);
+    m_cgroup        = Json::getString(value, kCgroup);
+}
@@ -0,0 +1,73 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PRESSURECONFIG_H
+#define XMRIG_PRESSURECONFIG_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class PressureConfig
+{
+public:
+    static const char *kCgroup;
+    static const char *kCpu;
+    static const char *kEnabled;
+    static const char *kField;
+    static const char *kInterval;
+    static const char *kIo;
+    static const char *kMemory;
+    static const char *kMinThreads;
+    static const char *kRestore;
+
+    PressureConfig() = default;
+
+    inline bool isEnabled() const               { return m_enabled; }
+    inline const String &cgroup() const         { return m_cgroup; }
+    inline double cpu() const                   { return m_cpu; }
+    inline double io() const                    { return m_io; }
+    inline double memory() const                { return m_memory; }
+    inline double restore() const               { return m_restore; }
+    inline uint32_t interval() const            { return m_interval; }
+    inline uint32_t minThreads() const          { return m_minThreads; }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void read(const rapidjson::Value &value);
+
+private:
+    bool m_enabled          = false;
+    double m_cpu            = 20.0;
+    double m_io             = 20.0;
+    double m_memory         = 10.0;
+    double m_restore        = 0.5;
+    String m_cgroup;
+    uint32_t m_interval     = 10;
+    uint32_t m_minThreads   = 1;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PRESSURECONFIG_H */
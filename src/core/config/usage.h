@@ -52,7 +52,9 @@ static inline const std::string &usage()
     u += "  -x, --proxy=HOST:PORT         connect through a SOCKS5 proxy\n";
     u += "  -k, --keepalive               send keepalived packet for prevent timeout (needs pool support)\n";
     u += "      --nicehash                enable nicehash.com support\n";
+    u += "      --min-diff=N              submit only shares with difficulty N or higher, ask the pool for it on login\n";
     u += "      --rig-id=ID               rig identifier for pool-side statistics (needs pool support)\n";
+    u += "      --weight=N                mine this pool at the same time as other weighted pools on a share N of the CPU threads\n";
 
 #   ifdef XMRIG_FEATURE_TLS
     u += "      --tls                     enable SSL/TLS support (needs pool support)\n";
@@ -174,6 +176,7 @@ static inline const std::string &usage()
 
 #   ifdef XMRIG_FEATURE_HWLOC
     u += "      --export-topology         export hwloc topology to a XML file and exit\n";
+    u += "      --topology-cache=FILE     cache hwloc topology in a XML file for faster startup, --dry-run refreshes it\n";
 #   endif
 
 #   ifdef XMRIG_OS_WIN
@@ -182,6 +185,11 @@ static inline const std::string &usage()
 #   endif
     u += "      --pause-on-battery        pause mine on battery power\n";
     u += "      --pause-on-active=N       pause mine when the user is active (resume after N seconds of last activity)\n";
+    u += "      --job-backlog=N           keep N previous jobs of the same block to mine when the nonce range runs out\n";
+    u += "      --replay=FILE             replay recorded pool jobs from FILE instead of connecting to pools\n";
+    u += "      --replay-report=FILE      save the replay report (time to first result, latency, stale results) to FILE\n";
+    u += "      --pressure                shed CPU threads while Linux pressure stall information is over the targets\n";
+    u += "      --pressure-cgroup=DIR     use the pressure files of the cgroup v2 directory DIR instead of /proc/pressure\n";
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     u += "      --stress                  run continuous stress test to check system stability\n";
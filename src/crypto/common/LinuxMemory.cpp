@@ -18,6 +18,7 @@
 
 #include "crypto/common/LinuxMemory.h"
 #include "3rdparty/fmt/core.h"
+#include "base/kernel/Cgroup.h"
 #include "crypto/common/VirtualMemory.h"
 
 
@@ -49,8 +50,19 @@ static inline int64_t nr_hugepages(uint32_t node, size_t hugePageSize)
 } // namespace xmrig
 
 
+// The hugetlb cgroup controller charges pages when they are faulted in, populating a mapping past its limit is a SIGBUS.
+bool xmrig::LinuxMemory::isAllowed(size_t size, size_t hugePageSize)
+{
+    return Cgroup::process().hugePages(hugePageSize) >= VirtualMemory::align(size, hugePageSize);
+}
+
+
 bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize)
 {
+    if (!isAllowed(size, hugePageSize)) {
+        return false;
+    }
+
     std::lock_guard<std::mutex> lock(mutex);
 
     const size_t required = VirtualMemory::align(size, hugePageSize) / hugePageSize;
@@ -30,6 +30,7 @@ namespace xmrig {
 class LinuxMemory
 {
 public:
+    static bool isAllowed(size_t size, size_t hugePageSize);
     static bool reserve(size_t size, uint32_t node, size_t hugePageSize);
 
     static bool write(const char *path, uint64_t value);
@@ -84,6 +84,15 @@ uint8_t *xmrig::MemoryPool::get(size_t size, uint32_t)
 }
 
 
+void xmrig::MemoryPool::prepare(uint32_t)
+{
+    if (m_memory && !m_prepared) {
+        m_memory->prefault();
+        m_prepared = true;
+    }
+}
+
+
 void xmrig::MemoryPool::release(uint32_t)
 {
     assert(m_refs > 0);
@@ -49,9 +49,11 @@ public:
 protected:
     bool isHugePages(uint32_t node) const override;
     uint8_t *get(size_t size, uint32_t node) override;
+    void prepare(uint32_t node) override;
     void release(uint32_t node) override;
 
 private:
+    bool m_prepared         = false;
     size_t m_refs           = 0;
     size_t m_offset         = 0;
     size_t m_alignOffset    = 0;
@@ -70,6 +70,24 @@ uint8_t *xmrig::NUMAMemoryPool::get(size_t size, uint32_t node)
 }
 
 
+// Called from a thread bound to the node, several nodes are prepared in parallel.
+void xmrig::NUMAMemoryPool::prepare(uint32_t node)
+{
+    if (!m_size || get(node)) {
+        return;
+    }
+
+    IMemoryPool *pool = new MemoryPool(m_nodeSize, m_hugePages, node);
+    pool->prepare(node);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_map.insert({ node, pool }).second) {
+        delete pool;
+    }
+}
+
+
 void xmrig::NUMAMemoryPool::release(uint32_t node)
 {
     const auto pool = get(node);
@@ -81,6 +99,8 @@ void xmrig::NUMAMemoryPool::release(uint32_t node)
 
 xmrig::IMemoryPool *xmrig::NUMAMemoryPool::get(uint32_t node) const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     return m_map.count(node) ? m_map.at(node) : nullptr;
 }
 
@@ -90,6 +110,8 @@ xmrig::IMemoryPool *xmrig::NUMAMemoryPool::getOrCreate(uint32_t node) const
     auto pool = get(node);
     if (!pool) {
         pool = new MemoryPool(m_nodeSize, m_hugePages, node);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_map.insert({ node, pool });
     }
 
@@ -33,6 +33,7 @@
 
 
 #include <map>
+#include <mutex>
 
 
 namespace xmrig {
@@ -52,6 +53,7 @@ public:
 protected:
     bool isHugePages(uint32_t node) const override;
     uint8_t *get(size_t size, uint32_t node) override;
+    void prepare(uint32_t node) override;
     void release(uint32_t node) override;
 
 private:
@@ -62,6 +64,7 @@ private:
     size_t m_nodeSize       = 0;
     size_t m_size           = 0;
     mutable std::map<uint32_t, IMemoryPool *> m_map;
+    mutable std::mutex m_mutex;
 };
 
 
@@ -27,6 +27,8 @@
 
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 
 namespace xmrig {
@@ -42,12 +44,18 @@ public:
         MAX
     };
 
+    // Counters 0 and 1 belong to the user and donate jobs, 2 + N to weighted pool partition N.
+    static constexpr uint8_t kPartitions = 8;
+
 
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
+    static inline bool isParked(size_t id)                              { return id >= m_threads.load(std::memory_order_relaxed); }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
+    static inline uint64_t counter(uint8_t index)                       { return m_nonces[index].load(std::memory_order_relaxed); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
     static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; }
+    static inline void reset(uint8_t index, uint64_t counter = 0)       { m_nonces[index] = counter; }
+    static inline void setThreads(uint32_t threads)                     { m_threads = threads; }
     static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
     static inline void touch(Backend backend)                           { m_sequence[backend]++; }
 
@@ -57,8 +65,9 @@ public:
 
 private:
     static std::atomic<bool> m_paused;
+    static std::atomic<uint32_t> m_threads;
     static std::atomic<uint64_t> m_sequence[MAX];
-    static std::atomic<uint64_t> m_nonces[2];
+    static std::atomic<uint64_t> m_nonces[2 + kPartitions];
 };
 
 
@@ -103,6 +103,21 @@ xmrig::HugePagesInfo xmrig::VirtualMemory::hugePages() const
 }
 
 
+// Huge pages are populated by mmap, regular pages are faulted in here by the calling thread, so they are local to its node.
+void xmrig::VirtualMemory::prefault()
+{
+    if (!m_scratchpad || isHugePages() || isOneGbPages() || m_flags.test(FLAG_EXTERNAL)) {
+        return;
+    }
+
+    constexpr size_t kPageSize = 4096;
+
+    for (size_t i = 0; i < m_size; i += kPageSize) {
+        m_scratchpad[i] = 0;
+    }
+}
+
+
 #ifndef XMRIG_FEATURE_HWLOC
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
@@ -117,6 +132,14 @@ void xmrig::VirtualMemory::destroy()
 }
 
 
+void xmrig::VirtualMemory::preparePool(uint32_t node)
+{
+    if (pool) {
+        pool->prepare(node);
+    }
+}
+
+
 void xmrig::VirtualMemory::init(size_t poolSize, size_t hugePageSize)
 {
     if (!pool) {
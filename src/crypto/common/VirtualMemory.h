@@ -55,6 +55,7 @@ public:
     inline static void flushInstructionCache(void *p1, void *p2)    { flushInstructionCache(p1, static_cast<uint8_t*>(p2) - static_cast<uint8_t*>(p1)); }
 
     HugePagesInfo hugePages() const;
+    void prefault();
 
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
@@ -69,6 +70,7 @@ public:
     static void flushInstructionCache(void *p, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
+    static void preparePool(uint32_t node);
 
     static inline constexpr size_t align(size_t pos, size_t align = kDefaultHugePageSize)   { return ((pos - 1) / align + 1) * align; }
     static inline size_t alignToHugePageSize(size_t pos)                                    { return align(pos, hugePageSize()); }
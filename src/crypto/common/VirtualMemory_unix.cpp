@@ -165,6 +165,12 @@ void *xmrig::VirtualMemory::allocateLargePagesMemory(size_t size)
 #   elif defined(__FreeBSD__)
     void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_ALIGNED_SUPER | MAP_PREFAULT_READ, -1, 0);
 #   else
+#   ifdef XMRIG_OS_LINUX
+    if (!LinuxMemory::isAllowed(size, hugePageSize())) {
+        return nullptr;
+    }
+#   endif
+
     void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(hugePageSize()), 0, 0);
 #   endif
 
@@ -175,7 +181,7 @@ void *xmrig::VirtualMemory::allocateLargePagesMemory(size_t size)
 void *xmrig::VirtualMemory::allocateOneGbPagesMemory(size_t size)
 {
 #   ifdef XMRIG_OS_LINUX
-    if (isOneGbPagesAvailable()) {
+    if (isOneGbPagesAvailable() && LinuxMemory::isAllowed(size, kOneGiB)) {
         void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(kOneGiB), 0, 0);
 
         return mem == MAP_FAILED ? nullptr : mem;
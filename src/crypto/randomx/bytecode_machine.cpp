@@ -78,6 +78,172 @@ namespace randomx {
 		}
 	}
 
+#ifdef RANDOMX_THREADED_INTERPRETER
+
+//instruction types in InstructionType order, each one gets its own handler
+#define RANDOMX_THREADED_TYPES(X) \
+	X(IADD_RS) X(IADD_M) X(ISUB_R) X(ISUB_M) X(IMUL_R) X(IMUL_M) X(IMULH_R) X(IMULH_M) \
+	X(ISMULH_R) X(ISMULH_M) X(IMUL_RCP) X(INEG_R) X(IXOR_R) X(IXOR_M) X(IROR_R) X(IROL_R) \
+	X(ISWAP_R) X(FSWAP_R) X(FADD_R) X(FADD_M) X(FSUB_R) X(FSUB_M) X(FSCAL_R) X(FMUL_R) \
+	X(FDIV_M) X(FSQRT_R) X(CBRANCH) X(CFROUND) X(ISTORE) X(NOP)
+
+//the most frequent register-only instructions, any adjacent pair of them runs as one superinstruction
+#define RANDOMX_FUSED_TYPES(X) X(IADD_RS) X(ISUB_R) X(IMUL_R) X(IXOR_R) X(FADD_R) X(FSUB_R) X(FMUL_R)
+#define RANDOMX_FUSED_TYPES_WITH(X, a) X(a, IADD_RS) X(a, ISUB_R) X(a, IMUL_R) X(a, IXOR_R) X(a, FADD_R) X(a, FSUB_R) X(a, FMUL_R)
+
+	enum ThreadedHandler {
+#define HANDLER_ENUM(x) Handler_##x,
+		RANDOMX_THREADED_TYPES(HANDLER_ENUM)
+#undef HANDLER_ENUM
+		HandlerFusedBase
+	};
+
+	static_assert(Handler_NOP == static_cast<int>(InstructionType::NOP), "RANDOMX_THREADED_TYPES must follow InstructionType");
+
+	enum FusedHandler {
+#define FUSED_ENUM(x) Fused_##x,
+		RANDOMX_FUSED_TYPES(FUSED_ENUM)
+#undef FUSED_ENUM
+		FusedCount
+	};
+
+	constexpr int HandlerEnd = HandlerFusedBase + FusedCount * FusedCount;
+
+	static int fusedIndex(InstructionType type) {
+		switch (type) {
+#define FUSED_CASE(x) case InstructionType::x: return Fused_##x;
+			RANDOMX_FUSED_TYPES(FUSED_CASE)
+#undef FUSED_CASE
+		default:
+			return -1;
+		}
+	}
+
+	void BytecodeMachine::threadProgram(InstructionByteCode* bytecode, unsigned size) {
+		static const void* const* handlers = executeThreaded(nullptr, nullptr, nullptr);
+
+		bool isTarget[RANDOMX_PROGRAM_MAX_SIZE + 1] = {};
+
+		for (unsigned i = 0; i < size; ++i) {
+			auto& ibc = bytecode[i];
+			ibc.handler = handlers[static_cast<int>(ibc.type)];
+			if (ibc.type == InstructionType::CBRANCH) {
+				isTarget[ibc.target + 1] = true;
+			}
+		}
+
+		//a branch may never land in the middle of a superinstruction
+		for (unsigned i = 0; i + 1 < size; ++i) {
+			const int a = fusedIndex(bytecode[i].type);
+			const int b = fusedIndex(bytecode[i + 1].type);
+			if (a >= 0 && b >= 0 && !isTarget[i + 1]) {
+				bytecode[i].handler = handlers[HandlerFusedBase + a * FusedCount + b];
+				++i;
+			}
+		}
+
+		bytecode[size].handler = handlers[HandlerEnd];
+	}
+
+	const void* const* BytecodeMachine::executeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration* config) {
+		static const void* const handlers[HandlerEnd + 1] = {
+#define HANDLER_ADDR(x) &&op_##x,
+#define FUSED_ADDR(a, b) &&op_##a##_##b,
+#define FUSED_ROW(a) RANDOMX_FUSED_TYPES_WITH(FUSED_ADDR, a)
+			RANDOMX_THREADED_TYPES(HANDLER_ADDR)
+			RANDOMX_FUSED_TYPES(FUSED_ROW)
+			&&op_END
+#undef FUSED_ROW
+#undef FUSED_ADDR
+#undef HANDLER_ADDR
+		};
+
+		if (bytecode == nullptr) {
+			return handlers;
+		}
+
+		InstructionByteCode* ip = bytecode;
+		int pc = 0; //only used by exe_CBRANCH which has its own handler below
+
+#define DISPATCH() goto *ip->handler
+
+#define HANDLER(x) \
+	op_##x: \
+		exe_##x(*ip, pc, scratchpad, *config); \
+		++ip; \
+		DISPATCH();
+
+#define FUSED_HANDLER(a, b) \
+	op_##a##_##b: \
+		exe_##a(ip[0], pc, scratchpad, *config); \
+		exe_##b(ip[1], pc, scratchpad, *config); \
+		ip += 2; \
+		DISPATCH();
+
+#define FUSED_HANDLER_ROW(a) RANDOMX_FUSED_TYPES_WITH(FUSED_HANDLER, a)
+
+		DISPATCH();
+
+		HANDLER(IADD_RS)
+		HANDLER(IADD_M)
+		HANDLER(ISUB_R)
+		HANDLER(ISUB_M)
+		HANDLER(IMUL_R)
+		HANDLER(IMUL_M)
+		HANDLER(IMULH_R)
+		HANDLER(IMULH_M)
+		HANDLER(ISMULH_R)
+		HANDLER(ISMULH_M)
+		HANDLER(INEG_R)
+		HANDLER(IXOR_R)
+		HANDLER(IXOR_M)
+		HANDLER(IROR_R)
+		HANDLER(IROL_R)
+		HANDLER(ISWAP_R)
+		HANDLER(FSWAP_R)
+		HANDLER(FADD_R)
+		HANDLER(FADD_M)
+		HANDLER(FSUB_R)
+		HANDLER(FSUB_M)
+		HANDLER(FSCAL_R)
+		HANDLER(FMUL_R)
+		HANDLER(FDIV_M)
+		HANDLER(FSQRT_R)
+		HANDLER(CFROUND)
+		HANDLER(ISTORE)
+
+		RANDOMX_FUSED_TYPES(FUSED_HANDLER_ROW)
+
+	op_CBRANCH:
+		*ip->idst += ip->imm;
+		if ((*ip->idst & ip->memMask) == 0) {
+			ip = bytecode + ip->target + 1;
+		}
+		else {
+			++ip;
+		}
+		DISPATCH();
+
+	op_IMUL_RCP: //executed as IMUL_R
+	op_NOP:
+		++ip;
+		DISPATCH();
+
+	op_END:
+		return nullptr;
+
+#undef FUSED_HANDLER_ROW
+#undef FUSED_HANDLER
+#undef HANDLER
+#undef DISPATCH
+	}
+
+#undef RANDOMX_FUSED_TYPES_WITH
+#undef RANDOMX_FUSED_TYPES
+#undef RANDOMX_THREADED_TYPES
+
+#endif
+
 	void BytecodeMachine::compileInstruction(RANDOMX_GEN_ARGS) {
 		uint32_t opcode = instr.opcode;
 
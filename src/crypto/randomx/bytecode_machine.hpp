@@ -33,6 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/instruction.hpp"
 #include "crypto/randomx/program.hpp"
 
+//direct-threaded dispatch needs the "labels as values" extension
+#if defined(__GNUC__) || defined(__clang__)
+#define RANDOMX_THREADED_INTERPRETER
+#endif
+
 namespace randomx {
 
 	//register file in machine byte order
@@ -62,6 +67,9 @@ namespace randomx {
 			uint16_t shift;
 		};
 		uint32_t memMask;
+#ifdef RANDOMX_THREADED_INTERPRETER
+		const void* handler;
+#endif
 	};
 
 #define RANDOMX_EXE_ARGS InstructionByteCode& ibc, int& pc, uint8_t* scratchpad, ProgramConfiguration& config
@@ -80,6 +88,7 @@ namespace randomx {
 			nreg = &regFile;
 		}
 
+		//bytecode must have room for ProgramSize + 1 entries, the last one terminates threaded dispatch
 		void compileProgram(Program& program, InstructionByteCode* bytecode, NativeRegisterFile& regFile) {
 			beginCompilation(regFile);
 			for (unsigned i = 0; i < RandomX_CurrentConfig.ProgramSize; ++i) {
@@ -87,13 +96,20 @@ namespace randomx {
 				auto& ibc = bytecode[i];
 				compileInstruction(instr, i, ibc);
 			}
+#ifdef RANDOMX_THREADED_INTERPRETER
+			threadProgram(bytecode, RandomX_CurrentConfig.ProgramSize);
+#endif
 		}
 
 		static void executeBytecode(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+#ifdef RANDOMX_THREADED_INTERPRETER
+			executeThreaded(bytecode, scratchpad, &config);
+#else
 			for (int pc = 0; pc < static_cast<int>(RandomX_CurrentConfig.ProgramSize); ++pc) {
 				auto& ibc = bytecode[pc];
 				executeInstruction(ibc, pc, scratchpad, config);
 			}
+#endif
 		}
 
 		void compileInstruction(RANDOMX_GEN_ARGS)
@@ -250,6 +266,14 @@ namespace randomx {
 			return scratchpad + addr;
 		}
 
+#ifdef RANDOMX_THREADED_INTERPRETER
+		//resolves handler addresses and superinstructions once per program
+		static void threadProgram(InstructionByteCode* bytecode, unsigned size);
+
+		//returns the handler table when called with bytecode == nullptr
+		static const void* const* executeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration* config);
+#endif
+
 #ifdef RANDOMX_GEN_TABLE
 		static InstructionGenBytecode genTable[256];
 
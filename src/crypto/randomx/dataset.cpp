@@ -159,6 +159,11 @@ namespace randomx {
 		memcpy(out, &rl, CacheLineSize);
 	}
 
+	// The first cache block of an item depends only on the item number, the rest depend on SuperscalarHash results.
+	void prefetchDatasetItem(randomx_cache* cache, uint64_t itemNumber) {
+		rx_prefetch_t0(getMixBlock(itemNumber, cache->memory));
+	}
+
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startItem, uint32_t endItem) {
 		for (uint32_t itemNumber = startItem; itemNumber < endItem; ++itemNumber, dataset += CacheLineSize)
 			initDatasetItem(cache, dataset, itemNumber);
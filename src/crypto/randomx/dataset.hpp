@@ -47,6 +47,7 @@ struct randomx_cache {
 	randomx::CacheInitializeFunc* initialize;
 	randomx::DatasetInitFunc* datasetInit;
 	randomx::SuperscalarProgram programs[RANDOMX_CACHE_MAX_ACCESSES];
+	const RandomX_ConfigurationBase* variantConfig = nullptr;
 
 	bool isInitialized() const {
 		return programs[0].getSize() != 0;
@@ -73,5 +74,6 @@ namespace randomx {
 	void initCache(randomx_cache*, const void*, size_t);
 	void initCacheCompile(randomx_cache*, const void*, size_t);
 	void initDatasetItem(randomx_cache* cache, uint8_t* out, uint64_t blockNumber);
+	void prefetchDatasetItem(randomx_cache* cache, uint64_t blockNumber);
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
 }
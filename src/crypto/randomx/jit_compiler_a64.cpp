@@ -48,6 +48,14 @@ void randomx_set_optimized_dataset_init(int value)
 	optimizedDatasetInit = value;
 }
 
+void randomx_set_jit_profile(int)
+{
+}
+
+void randomx_set_shared_jit_code(bool)
+{
+}
+
 namespace ARMV8A {
 
 constexpr uint32_t B           = 0x14000000;
@@ -146,7 +154,7 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 		Instruction& instr = program(i);
 		instr.src %= RegistersCount;
 		instr.dst %= RegistersCount;
-		(this->*engine[instr.opcode])(instr, codePos);
+		(this->*RandomX_CurrentConfig.JitEngine[instr.opcode])(instr, codePos);
 	}
 
 	// Update spMix2
@@ -206,7 +214,7 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 		Instruction& instr = program(i);
 		instr.src %= RegistersCount;
 		instr.dst %= RegistersCount;
-		(this->*engine[instr.opcode])(instr, codePos);
+		(this->*RandomX_CurrentConfig.JitEngine[instr.opcode])(instr, codePos);
 	}
 
 	// Update spMix2
@@ -1082,6 +1090,4 @@ void JitCompilerA64::h_NOP(Instruction& instr, uint32_t& codePos)
 {
 }
 
-InstructionGeneratorA64 JitCompilerA64::engine[256] = {};
-
 }
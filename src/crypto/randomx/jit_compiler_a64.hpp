@@ -41,9 +41,6 @@ namespace randomx {
 	class Program;
 	struct ProgramConfiguration;
 	class SuperscalarProgram;
-	class Instruction;
-
-	typedef void(JitCompilerA64::*InstructionGeneratorA64)(Instruction&, uint32_t&);
 
 	class JitCompilerA64 {
 	public:
@@ -74,8 +71,6 @@ namespace randomx {
 		void enableWriting() const;
 		void enableExecution() const;
 
-		static InstructionGeneratorA64 engine[256];
-
 	private:
 		const bool hugePages;
 		uint32_t reg_changed_offset[8]{};
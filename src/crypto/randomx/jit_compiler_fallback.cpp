@@ -38,3 +38,11 @@ void randomx_set_huge_pages_jit(bool)
 void randomx_set_optimized_dataset_init(int)
 {
 }
+
+void randomx_set_jit_profile(int)
+{
+}
+
+void randomx_set_shared_jit_code(bool)
+{
+}
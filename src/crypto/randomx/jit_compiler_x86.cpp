@@ -32,9 +32,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstring>
 #include <climits>
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 #include "crypto/randomx/jit_compiler_x86.hpp"
 #include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/jit_compiler_x86_static.hpp"
 #include "crypto/randomx/program.hpp"
@@ -53,6 +57,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 static bool hugePagesJIT = false;
 static int optimizedDatasetInit = -1;
+static int jitProfile = 0;
+static bool sharedJitCode = true;
 
 void randomx_set_huge_pages_jit(bool hugePages)
 {
@@ -64,6 +70,16 @@ void randomx_set_optimized_dataset_init(int value)
 	optimizedDatasetInit = value;
 }
 
+void randomx_set_jit_profile(int profile)
+{
+	jitProfile = profile;
+}
+
+void randomx_set_shared_jit_code(bool shared)
+{
+	sharedJitCode = shared;
+}
+
 namespace randomx {
 	/*
 
@@ -185,6 +201,34 @@ namespace randomx {
 		{0x0F, 0x1F, 0x44, 0x00, 0x00, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E},
 	};
 
+	// JIT code layout profiles:
+	// 0 = Auto detect, generic until a profile is shown to be faster in full hash execution
+	// 1 = Generic: packed program, 32-byte branch alignment only on CPUs with the JCC erratum
+	// 2 = Intel: program aligned to a 32-byte decoded icache window
+	// 3 = Zen: program aligned to a 64-byte op cache line
+	uint32_t JitCompilerX86::programAlign() {
+		switch (jitProfile) {
+		case 2:
+			return 32;
+
+		case 3:
+			return 64;
+
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
+	void JitCompilerX86::emitNops(uint32_t count, uint8_t* code, uint32_t& codePos) {
+		while (count > 0) {
+			const uint32_t n = (count > 9) ? 9 : count;
+			emit(NOPX[n - 1], n, code, codePos);
+			count -= n;
+		}
+	}
+
 	static inline uint8_t* alignToPage(uint8_t* p, size_t pageSize) {
 		size_t k = (size_t) p;
 		k -= k % pageSize;
@@ -192,7 +236,7 @@ namespace randomx {
 	}
 
 	size_t JitCompilerX86::getCodeSize() {
-		return codePos < prologueSize ? 0 : codePos - prologueSize;
+		return codePos < loopBegin ? 0 : codePos - loopBegin;
 	}
 
 	void JitCompilerX86::enableWriting() const {
@@ -216,6 +260,284 @@ namespace randomx {
 	static std::atomic<size_t> codeOffset;
 	constexpr size_t codeOffsetIncrement = 59 * 64;
 
+	// Offsets in the code shared by the programs of a region, see JitCodeRegions.
+	constexpr uint32_t programLoopBegin = 64;
+	#define sharedEpilogueOffset ((prologueSize + 63) & ~63)
+
+	// Builds the prologue and epilogue used by all programs of a region. The prologue of a program differs only in
+	// eMask and the address of its loop: the entry code of the program loads them into xmm1 and xmm0 (volatile in
+	// both ABIs, loaded from the scratchpad by the first iteration), the shared prologue moves eMask to xmm14 and
+	// jumps to the loop through rcx. Returns false if the static code doesn't have the expected layout.
+	static bool generateSharedCode(uint8_t* p, uint32_t scratchpadL3Mask, bool hasAVX) {
+		const uint32_t firstLoad = ADDR(randomx_program_prologue_first_load) - ADDR(randomx_program_prologue);
+
+		static const uint8_t LOAD_EMASK[]  = { 0x66, 0x44, 0x0F, 0x28, 0x35 };                         // movapd xmm14, [rip+exp240]
+		static const uint8_t MOVE_EMASK[]  = { 0x66, 0x44, 0x0F, 0x28, 0xF1, 0x0F, 0x1F, 0x40, 0x00 }; // movapd xmm14, xmm1; nop
+		static const uint8_t JUMP_LOOP[]   = { 0x66, 0x48, 0x0F, 0x7E, 0xC1, 0xFF, 0xE1 };             // movq rcx, xmm0; jmp rcx
+
+		const uint8_t* jmp = codePrologue + firstLoad + 64;
+		if (memcmp(codePrologue + firstLoad - 18, LOAD_EMASK, sizeof(LOAD_EMASK)) != 0 || jmp[0] != 0xEB || firstLoad + 66 + static_cast<int8_t>(jmp[1]) != prologueSize) {
+			return false;
+		}
+
+		memcpy(p, codePrologue, prologueSize);
+		*(uint32_t*)(p + firstLoad + 4) = scratchpadL3Mask;
+		*(uint32_t*)(p + firstLoad + 14) = scratchpadL3Mask;
+		if (hasAVX) {
+			uint32_t* k = (uint32_t*)(p + firstLoad + 61);
+			*k = (*k & 0xFF000000U) | 0x0077F8C5U;
+		}
+
+		// The 16 bytes between the constants and the loop begin are alignment padding.
+		memcpy(p + firstLoad - 18, MOVE_EMASK, sizeof(MOVE_EMASK));
+		p[firstLoad + 65] -= 16;
+		memcpy(p + prologueSize - 16, JUMP_LOOP, sizeof(JUMP_LOOP));
+
+		memcpy(p + sharedEpilogueOffset, codeEpilogue, epilogueSize);
+
+		return true;
+	}
+
+	// Executable code of all compilers lives in 2 MB regions of 64 KB units, so threads (and SMT siblings in particular)
+	// share iTLB entries and page tables for the JIT code. Regions for VM programs map the prologue and epilogue once,
+	// in the last unit, and keep one copy of each distinct SuperscalarHash, so the slot of a VM only holds its program,
+	// which reaches the shared code with rel32 offsets. The last unit is above all programs, so the main loop bounds
+	// of RxFix still end at the epilogue.
+	class JitCodeRegions {
+	public:
+		static constexpr size_t RegionSize = 2 * 1024 * 1024;
+		static constexpr uint32_t UnitCount = RegionSize / CodeSize;
+		static constexpr uint32_t SharedUnit = UnitCount - 1;
+
+		// Units for a compiler with its own prologue and epilogue.
+		static uint8_t* allocate(size_t size, bool hugePages) {
+			std::lock_guard<std::mutex> lock(mutex);
+
+			const uint32_t units = static_cast<uint32_t>(size / CodeSize);
+
+			for (auto& region : regions) {
+				if (region.programs || region.hugePages != hugePages) {
+					continue;
+				}
+
+				uint8_t* p = take(region, units);
+				if (p) {
+					return p;
+				}
+			}
+
+			Region& region = create(hugePages, false, 0);
+
+			LOG_VERBOSE("%s" CYAN_BOLD("JIT") " code region " CYAN_BOLD("#%zu") " %zu KB per compiler, huge pages %s",
+			            xmrig::Tags::randomx(), regions.size() - 1, size / 1024, hugePages ? "requested" : "disabled");
+
+			return take(region, units);
+		}
+
+		// Slot for the program of a VM, next to the shared code of the region, nullptr if the static code can't be shared.
+		static uint8_t* allocateProgram(bool hugePages, uint32_t scratchpadL3Mask, bool hasAVX, const uint8_t*& shared) {
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (!sharedCodeSupported) {
+				return nullptr;
+			}
+
+			for (auto& region : regions) {
+				if (!region.programs || region.hugePages != hugePages || region.scratchpadL3Mask != scratchpadL3Mask) {
+					continue;
+				}
+
+				uint8_t* p = take(region, ProgramUnits);
+				if (p) {
+					shared = region.base + SharedUnit * CodeSize;
+					return p;
+				}
+			}
+
+			uint8_t* code = static_cast<uint8_t*>(allocExecutableMemory(RegionSize, hugePages));
+			uint8_t* p = code + SharedUnit * CodeSize;
+
+#			ifdef XMRIG_SECURE_JIT
+			xmrig::VirtualMemory::protectRW(p, CodeSize);
+#			endif
+
+			if (!generateSharedCode(p, scratchpadL3Mask, hasAVX)) {
+				freePagedMemory(code, RegionSize);
+				sharedCodeSupported = false;
+
+				LOG_WARN("%s" CYAN_BOLD("JIT") " unexpected static code layout, each thread uses its own prologue and epilogue", xmrig::Tags::randomx());
+
+				return nullptr;
+			}
+
+#			ifdef XMRIG_SECURE_JIT
+			xmrig::VirtualMemory::protectRX(p, CodeSize);
+#			endif
+
+			Region& region = create(hugePages, true, scratchpadL3Mask, code);
+
+			LOG_INFO("%s" CYAN_BOLD("JIT") " code region " CYAN_BOLD("#%zu") " prologue and epilogue shared by up to " CYAN_BOLD("%u") " threads, huge pages %s",
+			         xmrig::Tags::randomx(), regions.size() - 1, SharedUnit / ProgramUnits, hugePages ? "requested" : "disabled");
+
+			shared = p;
+			return take(region, ProgramUnits);
+		}
+
+		// Returns the copy of the SuperscalarHash code in the region of the slot which the program should call, the
+		// copy in the slot itself if the region has no free unit. previous is released after the new one is taken.
+		static const uint8_t* shareSuperscalarHash(const uint8_t* slot, const uint8_t* code, size_t size, const uint8_t* previous) {
+			std::lock_guard<std::mutex> lock(mutex);
+
+			const uint8_t* result = code;
+			Region* region = find(slot);
+
+			if (region) {
+				for (auto& block : region->superscalar) {
+					if (block.size == size && memcmp(block.code, code, size) == 0) {
+						++block.refs;
+						result = block.code;
+						break;
+					}
+				}
+
+				uint8_t* p;
+				if (result == code && (p = take(*region, 1)) != nullptr) {
+#					ifdef XMRIG_SECURE_JIT
+					xmrig::VirtualMemory::protectRW(p, CodeSize);
+#					endif
+
+					memcpy(p, code, size);
+
+#					ifdef XMRIG_SECURE_JIT
+					xmrig::VirtualMemory::protectRX(p, CodeSize);
+#					endif
+
+					region->superscalar.push_back({ p, size, 1 });
+					result = p;
+
+					LOG_VERBOSE("%s" CYAN_BOLD("JIT") " SuperscalarHash code shared in region " CYAN_BOLD("#%zu") " (%zu bytes)",
+					            xmrig::Tags::randomx(), static_cast<size_t>(region - regions.data()), size);
+				}
+			}
+
+			releaseSuperscalarHash(previous);
+
+			return result;
+		}
+
+		// Releases a slot or the units of a compiler and its reference to a shared SuperscalarHash copy.
+		static void release(const uint8_t* ptr, const uint8_t* superscalar) {
+			std::lock_guard<std::mutex> lock(mutex);
+
+			releaseSuperscalarHash(superscalar);
+
+			Region* region = find(ptr);
+			if (region) {
+				const uint32_t unit = static_cast<uint32_t>((ptr - region->base) / CodeSize);
+				region->used &= ~(((1U << region->length[unit]) - 1) << unit);
+
+				freeIfEmpty(region);
+			}
+		}
+
+	private:
+		static constexpr uint32_t ProgramUnits = 2;
+
+		struct Block {
+			uint8_t* code;
+			size_t size;
+			uint32_t refs;
+		};
+
+		struct Region {
+			uint8_t* base;
+			bool hugePages;
+			bool programs;
+			uint32_t scratchpadL3Mask;
+			uint32_t used;
+			uint8_t length[UnitCount];
+			std::vector<Block> superscalar;
+		};
+
+		static Region& create(bool hugePages, bool programs, uint32_t scratchpadL3Mask, uint8_t* base = nullptr) {
+			Region region;
+			region.base             = base ? base : static_cast<uint8_t*>(allocExecutableMemory(RegionSize, hugePages));
+			region.hugePages        = hugePages;
+			region.programs         = programs;
+			region.scratchpadL3Mask = scratchpadL3Mask;
+			region.used             = programs ? (1U << SharedUnit) : 0;
+
+			memset(region.length, 0, sizeof(region.length));
+
+			regions.push_back(region);
+
+			return regions.back();
+		}
+
+		static void releaseSuperscalarHash(const uint8_t* code) {
+			Region* region = find(code);
+			if (!region) {
+				return;
+			}
+
+			for (size_t i = 0; i < region->superscalar.size(); ++i) {
+				Block& block = region->superscalar[i];
+				if (block.code != code) {
+					continue;
+				}
+
+				if (--block.refs == 0) {
+					region->used &= ~(1U << ((block.code - region->base) / CodeSize));
+					region->superscalar.erase(region->superscalar.begin() + i);
+
+					freeIfEmpty(region);
+				}
+
+				return;
+			}
+		}
+
+		static void freeIfEmpty(Region* region) {
+			if (region->used == (region->programs ? (1U << SharedUnit) : 0)) {
+				freePagedMemory(region->base, RegionSize);
+				regions.erase(regions.begin() + (region - regions.data()));
+			}
+		}
+
+		static Region* find(const uint8_t* ptr) {
+			for (auto& region : regions) {
+				if (ptr >= region.base && ptr < region.base + RegionSize) {
+					return &region;
+				}
+			}
+
+			return nullptr;
+		}
+
+		static uint8_t* take(Region& region, uint32_t units) {
+			const uint32_t mask = (1U << units) - 1;
+
+			for (uint32_t i = 0; i + units <= UnitCount; ++i) {
+				if (!(region.used & (mask << i))) {
+					region.used     |= mask << i;
+					region.length[i] = static_cast<uint8_t>(units);
+
+					return region.base + i * CodeSize;
+				}
+			}
+
+			return nullptr;
+		}
+
+		static bool sharedCodeSupported;
+		static std::mutex mutex;
+		static std::vector<Region> regions;
+	};
+
+	bool JitCodeRegions::sharedCodeSupported = true;
+	std::mutex JitCodeRegions::mutex;
+	std::vector<JitCodeRegions::Region> JitCodeRegions::regions;
+
 	JitCompilerX86::JitCompilerX86(bool hugePagesEnable, bool optimizedInitDatasetEnable) {
 		BranchesWithin32B = xmrig::Cpu::info()->jccErratum();
 
@@ -255,7 +577,8 @@ namespace randomx {
 						initDatasetAVX2 = (xmrig::Cpu::info()->cores() == xmrig::Cpu::info()->threads());
 						break;
 					case xmrig::ICpuInfo::ARCH_ZEN3:
-						// AVX2 init is faster on Zen3
+					case xmrig::ICpuInfo::ARCH_ZEN4:
+						// AVX2 init is faster on Zen3 and later
 						initDatasetAVX2 = true;
 						break;
 					}
@@ -268,45 +591,150 @@ namespace randomx {
 			initDatasetAVX2 = false;
 		}
 
+		if (!RandomX_CurrentConfig.DatasetInitAVX2_Supported) {
+			initDatasetAVX2 = false;
+		}
+
 		hasXOP = xmrig::Cpu::info()->hasXOP();
 
-		allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
-		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize,
-#			ifdef XMRIG_SECURE_JIT
-			false
-#			else
-			hugePagesJIT && hugePagesEnable
-#			endif
-		));
+#		ifdef XMRIG_SECURE_JIT
+		hugePages = false;
+#		else
+		hugePages = hugePagesJIT && hugePagesEnable;
+#		endif
+
+		// Programs of VMs share the prologue and epilogue, compilers of dataset init code use all of their units
+		if (sharedJitCode && !optimizedInitDatasetEnable) {
+			sharedL3Mask = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
+			allocatedCode = JitCodeRegions::allocateProgram(hugePages, sharedL3Mask, hasAVX, sharedCode);
+		}
+
+		const size_t offset = codeOffset.fetch_add(codeOffsetIncrement) % CodeSize;
+
+		if (sharedCode) {
+			allocatedSize = CodeSize * 2;
+		}
+		else {
+			allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
+
+			if (sharedJitCode) {
+				allocatedCode = JitCodeRegions::allocate(allocatedSize, hugePages);
+			}
+			else {
+				allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePages));
+				ownMapping = true;
+			}
+		}
 
 		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
-		code = allocatedCode + (codeOffset.fetch_add(codeOffsetIncrement) % CodeSize);
+		code = allocatedCode + offset;
+
+		if (sharedCode) {
+			generateProgramEntry();
+		}
+		else {
+			loopBegin = prologueSize;
+			eMaskPos = prologueSize - 48;
+			epilogue = code + epilogueOffset;
+
+			memcpy(code, codePrologue, prologueSize);
+			memcpy(code + epilogueOffset, codeEpilogue, epilogueSize);
+		}
 
-		memcpy(code, codePrologue, prologueSize);
 		if (hasXOP) {
-			memcpy(code + prologueSize, codeLoopLoadXOP, loopLoadXOPSize);
+			memcpy(code + loopBegin, codeLoopLoadXOP, loopLoadXOPSize);
 		}
 		else {
-			memcpy(code + prologueSize, codeLoopLoad, loopLoadSize);
+			memcpy(code + loopBegin, codeLoopLoad, loopLoadSize);
 		}
-		memcpy(code + epilogueOffset, codeEpilogue, epilogueSize);
 
-		codePosFirst = prologueSize + (hasXOP ? loopLoadXOPSize : loopLoadSize);
+		codePosFirst = loopBegin + (hasXOP ? loopLoadXOPSize : loopLoadSize);
+		superscalarHash = code + superScalarHashOffset;
+
+		// Loop begin is 64-byte aligned in the static code and code offsets are multiples of 64, so padding is relative to it
+		const uint32_t align = programAlign();
+		if (align > 1) {
+			emitNops((align - (codePosFirst % align)) % align, code, codePosFirst);
+		}
 
 #		ifdef XMRIG_FIX_RYZEN
-		mainLoopBounds.first = code + prologueSize;
-		mainLoopBounds.second = code + epilogueOffset;
+		mainLoopBounds.first = code + loopBegin;
+		mainLoopBounds.second = epilogue;
 #		endif
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
 		codeOffset.fetch_sub(codeOffsetIncrement);
-		freePagedMemory(allocatedCode, allocatedSize);
+
+		if (ownMapping) {
+			freePagedMemory(allocatedCode, allocatedSize);
+		}
+		else {
+			JitCodeRegions::release(allocatedCode, superscalarHash);
+		}
+	}
+
+	// Entry of a program which uses the shared prologue: the code which passes eMask and the address of the loop to
+	// the prologue in xmm1 and xmm0, eMask in the last 16 bytes before the loop.
+	void JitCompilerX86::generateProgramEntry() {
+		static const uint8_t LOAD_EMASK[] = { 0xF3, 0x0F, 0x6F, 0x0D };       // movdqu xmm1, [rip+disp32]
+		static const uint8_t LEA_LOOP[]   = { 0x48, 0x8D, 0x05 };             // lea rax, [rip+disp32]
+		static const uint8_t MOVQ_LOOP[]  = { 0x66, 0x48, 0x0F, 0x6E, 0xC0 }; // movq xmm0, rax
+
+		loopBegin = programLoopBegin;
+		eMaskPos = programLoopBegin - 16;
+		epilogue = sharedCode + sharedEpilogueOffset;
+
+		uint32_t pos = 0;
+		emit(LOAD_EMASK, code, pos);
+		emit32(eMaskPos - (pos + 4), code, pos);
+		emit(LEA_LOOP, code, pos);
+		emit32(loopBegin - (pos + 4), code, pos);
+		emit(MOVQ_LOOP, code, pos);
+		emitByte(0xE9, code, pos);
+		emit32(static_cast<uint32_t>(sharedCode - (code + pos + 4)), code, pos);
+		emitNops(eMaskPos - pos, code, pos);
+	}
+
+	// The shared prologue has the L3 mask of the configuration the VM was created with, a program for another
+	// configuration moves to a region with a matching prologue.
+	void JitCompilerX86::moveToSharedCode(uint32_t scratchpadL3Mask) {
+		const uint8_t* shared = nullptr;
+		uint8_t* slot = JitCodeRegions::allocateProgram(hugePages, scratchpadL3Mask, hasAVX, shared);
+		if (!slot) {
+			throw std::runtime_error("JIT code region allocation failed");
+		}
+
+		uint8_t* prev = code;
+		const uint8_t* prevSuperscalarHash = superscalarHash;
+
+		code = slot + (code - allocatedCode);
+
+#		ifdef XMRIG_SECURE_JIT
+		enableWriting();
+#		endif
+
+		memcpy(code, prev, CodeSize);
+		JitCodeRegions::release(allocatedCode, nullptr);
+
+		allocatedCode = slot;
+		sharedCode = shared;
+		sharedL3Mask = scratchpadL3Mask;
+
+		generateProgramEntry();
+
+		superscalarHash = code + superScalarHashOffset;
+		if (prevSuperscalarHash != prev + superScalarHashOffset) {
+			superscalarHash = JitCodeRegions::shareSuperscalarHash(code, superscalarHash, superscalarHashSize, prevSuperscalarHash);
+		}
+
+#		ifdef XMRIG_FIX_RYZEN
+		mainLoopBounds.first = code + loopBegin;
+		mainLoopBounds.second = epilogue;
+#		endif
 	}
 
 	void JitCompilerX86::prepare() {
-		for (size_t i = 0; i < sizeof(engine); i += 64)
-			rx_prefetch_nta((const char*)(&engine) + i);
 		for (size_t i = 0; i < sizeof(RandomX_CurrentConfig); i += 64)
 			rx_prefetch_nta((const char*)(&RandomX_CurrentConfig) + i);
 	}
@@ -322,7 +750,7 @@ namespace randomx {
 
 		generateProgramPrologue(prog, pcfg);
 
-		uint8_t* p;
+		const uint8_t* p;
 		uint32_t n;
 		if (flags & RANDOMX_FLAG_AMD) {
 			p = RandomX_CurrentConfig.codeReadDatasetRyzenTweaked;
@@ -344,8 +772,28 @@ namespace randomx {
 		*(uint32_t*)(code + codePos) = 0xc381;
 		codePos += 2;
 		emit32(datasetOffset / CacheLineSize, code, codePos);
+
+		// The next item number is already in the high half of rbp, its first cache block depends only on
+		// the item number, so fetch it while SuperscalarHash computes the current item.
+		static const uint8_t PREFETCH_NEXT_ITEM[] = {
+			0x48, 0x8B, 0xCD,             // mov rcx, rbp
+			0x48, 0xC1, 0xE9, 0x20,       // shr rcx, 32
+			0x81, 0xE1,                   // and ecx, DatasetBaseMask
+		};
+
+		emit(PREFETCH_NEXT_ITEM, sizeof(PREFETCH_NEXT_ITEM), code, codePos);
+		emit32(RandomX_CurrentConfig.DatasetBaseSize - RANDOMX_DATASET_ITEM_SIZE, code, codePos);
+		emit32(0x8106E9C1, code, codePos);       // shr ecx, 6; add ecx, datasetOffset / 64
+		emitByte(0xC1, code, codePos);
+		emit32(datasetOffset / CacheLineSize, code, codePos);
+		*(uint16_t*)(code + codePos) = 0xE181;  // and ecx, cache mask
+		codePos += 2;
+		emit32(RandomX_CurrentConfig.ArgonMemory * 16 - 1, code, codePos);
+		emit32(0x06E1C148, code, codePos);       // shl rcx, 6
+		emit32(0x0F0C180F, code, codePos);       // prefetcht0 [rdi+rcx]
+
 		emitByte(0xe8, code, codePos);
-		emit32(superScalarHashOffset - (codePos + 4), code, codePos);
+		emit32(static_cast<uint32_t>(superscalarHash - (code + codePos + 4)), code, codePos);
 		emit(codeReadDatasetLightSshFin, readDatasetLightFinSize, code, codePos);
 		generateProgramEpilogue(prog, pcfg);
 	}
@@ -403,6 +851,12 @@ namespace randomx {
 			}
 		}
 		emitByte(0xc3, code, codePos);
+
+		// Light VMs with the same cache call one copy of the code
+		superscalarHashSize = codePos - superScalarHashOffset;
+		if (sharedCode) {
+			superscalarHash = JitCodeRegions::shareSuperscalarHash(code, code + superScalarHashOffset, superscalarHashSize, superscalarHash);
+		}
 	}
 
 	template
@@ -416,19 +870,26 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::generateProgramPrologue(Program& prog, ProgramConfiguration& pcfg) {
-		codePos = ADDR(randomx_program_prologue_first_load) - ADDR(randomx_program_prologue);
-		*(uint32_t*)(code + codePos + 4) = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
-		*(uint32_t*)(code + codePos + 14) = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
-		if (hasAVX) {
-			uint32_t* p = (uint32_t*)(code + codePos + 61);
-			*p = (*p & 0xFF000000U) | 0x0077F8C5U;
+		if (sharedCode) {
+			if (sharedL3Mask != RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated) {
+				moveToSharedCode(RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated);
+			}
+		}
+		else {
+			codePos = ADDR(randomx_program_prologue_first_load) - ADDR(randomx_program_prologue);
+			*(uint32_t*)(code + codePos + 4) = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
+			*(uint32_t*)(code + codePos + 14) = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
+			if (hasAVX) {
+				uint32_t* p = (uint32_t*)(code + codePos + 61);
+				*p = (*p & 0xFF000000U) | 0x0077F8C5U;
+			}
 		}
 
 #		ifdef XMRIG_FIX_RYZEN
         xmrig::RxFix::setMainLoopBounds(mainLoopBounds);
 #		endif
 
-		memcpy(code + prologueSize - 48, &pcfg.eMask, sizeof(pcfg.eMask));
+		memcpy(code + eMaskPos, &pcfg.eMask, sizeof(pcfg.eMask));
 		codePos = codePosFirst;
 		prevCFROUND = 0;
 
@@ -440,6 +901,8 @@ namespace randomx {
 			r[j] = k;
 		}
 
+		const InstructionGeneratorX86* engine = RandomX_CurrentConfig.JitEngine;
+
 		for (int i = 0, n = static_cast<int>(RandomX_CurrentConfig.ProgramSize); i < n; i += 4) {
 			Instruction& instr1 = prog(i);
 			Instruction& instr2 = prog(i + 1);
@@ -474,20 +937,15 @@ namespace randomx {
 
 			// If the jump crosses or touches 32-byte boundary, align it
 			if ((branch_begin ^ branch_end) >= 32) {
-				uint32_t alignment_size = 32 - (branch_begin & 31);
-				if (alignment_size > 8) {
-					emit(NOPX[alignment_size - 9], alignment_size - 8, code, codePos);
-					alignment_size = 8;
-				}
-				emit(NOPX[alignment_size - 1], alignment_size, code, codePos);
+				emitNops(32 - (branch_begin & 31), code, codePos);
 			}
 		}
 
 		*(uint64_t*)(code + codePos) = 0x850f01eb83ull;
 		codePos += 5;
-		emit32(prologueSize - codePos - 4, code, codePos);
+		emit32(loopBegin - codePos - 4, code, codePos);
 		emitByte(0xe9, code, codePos);
-		emit32(epilogueOffset - codePos - 4, code, codePos);
+		emit32(static_cast<uint32_t>(epilogue - (code + codePos + 4)), code, codePos);
 	}
 
 	template<bool AVX2>
@@ -1426,6 +1884,4 @@ namespace randomx {
 		emitByte(0x90, code, codePos);
 	}
 
-	alignas(64) InstructionGeneratorX86 JitCompilerX86::engine[256] = {};
-
 }
@@ -40,10 +40,6 @@ namespace randomx {
 	class Program;
 	struct ProgramConfiguration;
 	class SuperscalarProgram;
-	class JitCompilerX86;
-	class Instruction;
-
-	typedef void(*InstructionGeneratorX86)(JitCompilerX86*, const Instruction&);
 
 	constexpr uint32_t CodeSize = 64 * 1024;
 
@@ -81,7 +77,8 @@ namespace randomx {
 		void enableWriting() const;
 		void enableExecution() const;
 
-		alignas(64) static InstructionGeneratorX86 engine[256];
+		//alignment of the first program instruction inside the main loop, 0 = packed
+		static uint32_t programAlign();
 
 	private:
 		int registerUsage[RegistersCount] = {};
@@ -103,7 +100,21 @@ namespace randomx {
 
 		uint8_t* allocatedCode = nullptr;
 		size_t allocatedSize = 0;
+		bool ownMapping = false;
+		bool hugePages = false;
+
+		// Prologue and epilogue shared by the programs of a code region, nullptr if the program has its own
+		const uint8_t* sharedCode = nullptr;
+		uint32_t sharedL3Mask = 0;
+
+		uint32_t loopBegin = 0;
+		uint32_t eMaskPos = 0;
+		const uint8_t* epilogue = nullptr;
+		const uint8_t* superscalarHash = nullptr;
+		uint32_t superscalarHashSize = 0;
 
+		void generateProgramEntry();
+		void moveToSharedCode(uint32_t scratchpadL3Mask);
 		void generateProgramPrologue(Program&, ProgramConfiguration&);
 		void generateProgramEpilogue(Program&, ProgramConfiguration&);
 		template<bool rax>
@@ -111,6 +122,7 @@ namespace randomx {
 		static void genAddressRegDst(const Instruction&, uint8_t* code, uint32_t& codePos);
 		static void genAddressImm(const Instruction&, uint8_t* code, uint32_t& codePos);
 		static uint32_t genSIB(int scale, int index, int base) { return (scale << 6) | (index << 3) | base; }
+		static void emitNops(uint32_t count, uint8_t* code, uint32_t& codePos);
 
 		template<bool AVX2>
 		void generateSuperscalarCode(Instruction& inst, uint8_t* code, uint32_t& codePos);
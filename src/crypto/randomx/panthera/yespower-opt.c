@@ -1018,6 +1018,280 @@ static void smix(uint8_t *B, size_t r, uint32_t N,
 #include "yespower-opt.c"
 #undef smix
 
+/*
+ * Specialised yespower 1.0 with N = 2048, r = 8 and no personalization, as
+ * used by Panthera.  The pwxform macros of the second pass are still in
+ * effect here.  With r = 8 there are 16 sub-blocks, so the blockmix loops are
+ * fully unrolled and the loop counts of smix are compile-time constants.
+ */
+#define R8_N 2048
+#define R8_R 8
+#define R8_S (2 * R8_R)
+#define R8_NLOOP_RW ((((R8_N + 2) / 3) + 1) & ~1)
+
+#define R8_UNROLL_15(STEP) \
+	STEP(0) STEP(1) STEP(2) STEP(3) STEP(4) STEP(5) STEP(6) STEP(7) \
+	STEP(8) STEP(9) STEP(10) STEP(11) STEP(12) STEP(13) STEP(14)
+
+#define R8_DECL_CTX \
+	uint8_t *S0 = ctx->S0, *S1 = ctx->S1, *S2 = ctx->S2; \
+	size_t w = ctx->w;
+
+#define R8_SAVE_CTX \
+	ctx->S0 = S0; ctx->S1 = S1; ctx->S2 = S2; \
+	ctx->w = w;
+
+#ifdef PREFETCH
+#define R8_PREFETCH_STEP(i) PREFETCH(&Bin2[i], _MM_HINT_T0)
+#define R8_PREFETCH \
+	R8_UNROLL_15(R8_PREFETCH_STEP) R8_PREFETCH_STEP(15)
+#else
+#define R8_PREFETCH
+#endif
+
+static void blockmix_r8(const salsa20_blk_t *restrict Bin,
+    salsa20_blk_t *restrict Bout, pwxform_ctx_t *restrict ctx)
+{
+	R8_DECL_CTX
+	DECL_X
+
+	READ_X(Bin[R8_S - 1])
+
+	DECL_SMASK2REG
+
+#define R8_BLOCKMIX_STEP(i) \
+	XOR_X(Bin[i]) \
+	PWXFORM \
+	WRITE_X(Bout[i])
+
+	R8_UNROLL_15(R8_BLOCKMIX_STEP)
+	XOR_X(Bin[15])
+	PWXFORM
+
+#undef R8_BLOCKMIX_STEP
+
+	R8_SAVE_CTX
+
+	SALSA20(Bout[15])
+}
+
+static uint32_t blockmix_xor_r8(const salsa20_blk_t *restrict Bin1,
+    const salsa20_blk_t *restrict Bin2, salsa20_blk_t *restrict Bout,
+    pwxform_ctx_t *restrict ctx)
+{
+	R8_DECL_CTX
+	DECL_X
+
+	R8_PREFETCH
+
+	XOR_X_2(Bin1[R8_S - 1], Bin2[R8_S - 1])
+
+	DECL_SMASK2REG
+
+#define R8_BLOCKMIX_XOR_STEP(i) \
+	XOR_X(Bin1[i]) \
+	XOR_X(Bin2[i]) \
+	PWXFORM \
+	WRITE_X(Bout[i])
+
+	R8_UNROLL_15(R8_BLOCKMIX_XOR_STEP)
+	XOR_X(Bin1[15])
+	XOR_X(Bin2[15])
+	PWXFORM
+
+#undef R8_BLOCKMIX_XOR_STEP
+
+	R8_SAVE_CTX
+
+	SALSA20(Bout[15])
+
+	return INTEGERIFY;
+}
+
+static uint32_t blockmix_xor_save_r8(salsa20_blk_t *restrict Bin1out,
+    salsa20_blk_t *restrict Bin2, pwxform_ctx_t *restrict ctx)
+{
+	R8_DECL_CTX
+	DECL_X
+	DECL_Y
+
+	R8_PREFETCH
+
+	XOR_X_2(Bin1out[R8_S - 1], Bin2[R8_S - 1])
+
+	DECL_SMASK2REG
+
+#define R8_BLOCKMIX_XOR_SAVE_STEP(i) \
+	XOR_X_WRITE_XOR_Y_2(Bin2[i], Bin1out[i]) \
+	PWXFORM \
+	WRITE_X(Bin1out[i])
+
+	R8_UNROLL_15(R8_BLOCKMIX_XOR_SAVE_STEP)
+	XOR_X_WRITE_XOR_Y_2(Bin2[15], Bin1out[15])
+	PWXFORM
+
+#undef R8_BLOCKMIX_XOR_SAVE_STEP
+
+	R8_SAVE_CTX
+
+	SALSA20(Bin1out[15])
+
+	return INTEGERIFY;
+}
+
+/**
+ * smix1_r8(B, V, XY, ctx):
+ * smix1_1_0(B, 8, 2048, V, XY, ctx) with the blockmix calls specialised.
+ */
+static void smix1_r8(uint8_t *B, salsa20_blk_t *V, salsa20_blk_t *XY,
+    pwxform_ctx_t *ctx)
+{
+	salsa20_blk_t *X = V, *Y = &V[R8_S], *V_j;
+	uint32_t i, j, n;
+
+	for (i = 0; i < 2; i++) {
+		const salsa20_blk_t *src = (salsa20_blk_t *)&B[i * 64];
+		salsa20_blk_t *tmp = Y;
+		salsa20_blk_t *dst = &X[i];
+		size_t k;
+		for (k = 0; k < 16; k++)
+			tmp->w[k] = le32dec(&src->w[k]);
+		salsa20_simd_shuffle(tmp, dst);
+	}
+
+	for (i = 1; i < R8_R; i++)
+		blockmix_1_0(&X[(i - 1) * 2], &X[i * 2], 1, ctx);
+
+	blockmix_r8(X, Y, ctx);
+	X = Y + R8_S;
+	blockmix_r8(Y, X, ctx);
+	j = integerify(X, R8_R);
+
+	for (n = 2; n < R8_N; n <<= 1) {
+		uint32_t m = (n < R8_N / 2) ? n : (R8_N - 1 - n);
+		for (i = 1; i < m; i += 2) {
+			Y = X + R8_S;
+			j &= n - 1;
+			j += i - 1;
+			V_j = &V[j * R8_S];
+			j = blockmix_xor_r8(X, V_j, Y, ctx);
+			j &= n - 1;
+			j += i;
+			V_j = &V[j * R8_S];
+			X = Y + R8_S;
+			j = blockmix_xor_r8(Y, V_j, X, ctx);
+		}
+	}
+	n >>= 1;
+
+	j &= n - 1;
+	j += R8_N - 2 - n;
+	V_j = &V[j * R8_S];
+	Y = X + R8_S;
+	j = blockmix_xor_r8(X, V_j, Y, ctx);
+	j &= n - 1;
+	j += R8_N - 1 - n;
+	V_j = &V[j * R8_S];
+	blockmix_xor_r8(Y, V_j, XY, ctx);
+
+	for (i = 0; i < R8_S; i++) {
+		const salsa20_blk_t *src = &XY[i];
+		salsa20_blk_t *tmp = &XY[R8_S];
+		salsa20_blk_t *dst = (salsa20_blk_t *)&B[i * 64];
+		size_t k;
+		for (k = 0; k < 16; k++)
+			le32enc(&tmp->w[k], src->w[k]);
+		salsa20_simd_unshuffle(tmp, dst);
+	}
+}
+
+/**
+ * smix2_r8(B, V, XY, ctx):
+ * smix2_1_0(B, 8, 2048, Nloop_rw, V, XY, ctx) with the blockmix calls
+ * specialised.
+ */
+static void smix2_r8(uint8_t *B, salsa20_blk_t *V, salsa20_blk_t *XY,
+    pwxform_ctx_t *ctx)
+{
+	salsa20_blk_t *X = XY, *Y = &XY[R8_S];
+	uint32_t i, j, Nloop = R8_NLOOP_RW;
+
+	for (i = 0; i < R8_S; i++) {
+		const salsa20_blk_t *src = (salsa20_blk_t *)&B[i * 64];
+		salsa20_blk_t *tmp = Y;
+		salsa20_blk_t *dst = &X[i];
+		size_t k;
+		for (k = 0; k < 16; k++)
+			tmp->w[k] = le32dec(&src->w[k]);
+		salsa20_simd_shuffle(tmp, dst);
+	}
+
+	j = integerify(X, R8_R) & (R8_N - 1);
+
+	do {
+		salsa20_blk_t *V_j = &V[j * R8_S];
+		j = blockmix_xor_save_r8(X, V_j, ctx) & (R8_N - 1);
+		V_j = &V[j * R8_S];
+		j = blockmix_xor_save_r8(X, V_j, ctx) & (R8_N - 1);
+	} while (Nloop -= 2);
+
+	for (i = 0; i < R8_S; i++) {
+		const salsa20_blk_t *src = &X[i];
+		salsa20_blk_t *tmp = Y;
+		salsa20_blk_t *dst = (salsa20_blk_t *)&B[i * 64];
+		size_t k;
+		for (k = 0; k < 16; k++)
+			le32enc(&tmp->w[k], src->w[k]);
+		salsa20_simd_unshuffle(tmp, dst);
+	}
+}
+
+/**
+ * yespower_1_0_2048_8(memory, src, srclen, dst):
+ * Compute yespower 1.0 with N = 2048, r = 8 and no personalization, the same
+ * as yespower() with these parameters.
+ */
+void yespower_1_0_2048_8(void *memory, const uint8_t *src, size_t srclen,
+    yespower_binary_t *dst)
+{
+	const size_t B_size = (size_t)128 * R8_R;
+	const size_t V_size = B_size * R8_N;
+	const size_t XY_size = B_size + 64;
+	uint8_t *B = (uint8_t *)memory;
+	salsa20_blk_t *V = (salsa20_blk_t *)(B + B_size);
+	salsa20_blk_t *XY = (salsa20_blk_t *)((uint8_t *)V + V_size);
+	uint8_t *S = (uint8_t *)XY + XY_size;
+	pwxform_ctx_t ctx;
+	uint8_t sha256[32];
+
+	ctx.Sbytes = 3 * Swidth_to_Sbytes1(Swidth_1_0);
+	ctx.S0 = S;
+	ctx.S1 = S + Swidth_to_Sbytes1(Swidth_1_0);
+	ctx.S2 = S + 2 * Swidth_to_Sbytes1(Swidth_1_0);
+	ctx.w = 0;
+
+	SHA256_Buf(src, srclen, sha256);
+	PBKDF2_SHA256(sha256, sizeof(sha256), src, 0, 1, B, 128);
+	memcpy(sha256, B, sizeof(sha256));
+
+	smix1_1_0(B, 1, ctx.Sbytes / 128, (salsa20_blk_t *)ctx.S0, XY, NULL);
+	smix1_r8(B, V, XY, &ctx);
+	smix2_r8(B, V, XY, &ctx);
+
+	HMAC_SHA256_Buf(B + B_size - 64, 64, sha256, sizeof(sha256),
+	    (uint8_t *)dst);
+}
+
+#undef R8_N
+#undef R8_R
+#undef R8_S
+#undef R8_NLOOP_RW
+#undef R8_UNROLL_15
+#undef R8_DECL_CTX
+#undef R8_SAVE_CTX
+#undef R8_PREFETCH
+#undef R8_PREFETCH_STEP
+
 /**
  * yespower(local, src, srclen, params, dst):
  * Compute yespower(src[0 .. srclen - 1], N, r), to be checked for "< target".
@@ -1150,4 +1424,26 @@ int yespower_free_local(yespower_local_t *local)
 {
 	return free_region(local);
 }
+
+size_t yespower_local_size(const yespower_params_t *params)
+{
+	size_t B_size = (size_t)128 * params->r;
+
+	if (params->version == YESPOWER_0_5)
+		return B_size + B_size * params->N + B_size * 2 +
+		    2 * Swidth_to_Sbytes1(Swidth_0_5);
+
+	return B_size + B_size * params->N + B_size + 64 +
+	    3 * Swidth_to_Sbytes1(Swidth_1_0);
+}
+
+int yespower_init_local_region(yespower_local_t *local, void *memory,
+    size_t size)
+{
+	local->base = NULL;
+	local->base_size = 0;
+	local->aligned = memory;
+	local->aligned_size = memory ? size : 0;
+	return 0;
+}
 #endif
@@ -580,3 +580,30 @@ int yespower_free_local(yespower_local_t *local)
 	(void)local; /* unused */
 	return 0;
 }
+
+size_t yespower_local_size(const yespower_params_t *params)
+{
+/* The reference implementation allocates its memory in yespower() */
+	(void)params; /* unused */
+	return 0;
+}
+
+int yespower_init_local_region(yespower_local_t *local, void *memory,
+    size_t size)
+{
+/* The reference implementation doesn't use the local structure */
+	(void)memory; /* unused */
+	(void)size; /* unused */
+	return yespower_init_local(local);
+}
+
+void yespower_1_0_2048_8(void *memory, const uint8_t *src, size_t srclen,
+    yespower_binary_t *dst)
+{
+/* The reference implementation is not specialised */
+	static const yespower_params_t params = {
+		YESPOWER_1_0, 2048, 8, NULL, 0
+	};
+	(void)memory; /* unused */
+	yespower_tls(src, srclen, &params, dst);
+}
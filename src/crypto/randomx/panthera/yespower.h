@@ -95,6 +95,26 @@ extern int yespower_init_local(yespower_local_t *local);
  */
 extern int yespower_free_local(yespower_local_t *local);
 
+/**
+ * yespower_local_size(params):
+ * Return the size of the memory yespower() uses for params, so that it can be
+ * provided by the caller with yespower_init_local_region().
+ */
+extern size_t yespower_local_size(const yespower_params_t *params);
+
+/**
+ * yespower_init_local_region(local, memory, size):
+ * Initialize the thread-local (RAM) data structure to use memory, which is
+ * owned by the caller and is not freed by yespower_free_local().  If size is
+ * less than yespower_local_size(), yespower() allocates memory of its own.
+ *
+ * Return 0 on success; or -1 on error.
+ *
+ * MT-safe as long as local is local to the thread.
+ */
+extern int yespower_init_local_region(yespower_local_t *local, void *memory,
+    size_t size);
+
 /**
  * yespower(local, src, srclen, params, dst):
  * Compute yespower(src[0 .. srclen - 1], N, r), to be checked for "< target".
@@ -123,6 +143,18 @@ extern int yespower(yespower_local_t *local,
 extern int yespower_tls(const uint8_t *src, size_t srclen,
     const yespower_params_t *params, yespower_binary_t *dst);
 
+/**
+ * yespower_1_0_2048_8(memory, src, srclen, dst):
+ * Compute yespower(src[0 .. srclen - 1], N, r) for version 1.0, N = 2048,
+ * r = 8 and no personalization, bit-exact with yespower() for these params.
+ * memory is owned by the caller, must be aligned to 64 bytes and be at least
+ * yespower_local_size() bytes for these params.  No parameters are checked.
+ *
+ * MT-safe as long as memory and dst are local to the thread.
+ */
+extern void yespower_1_0_2048_8(void *memory,
+    const uint8_t *src, size_t srclen, yespower_binary_t *dst);
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,7 @@ extern "C" {
 }
 
 #include "crypto/rx/Profiler.h"
+#include "crypto/rx/RxPhaseGate.h"
 
 RandomX_ConfigurationWownero::RandomX_ConfigurationWownero()
 {
@@ -119,6 +120,8 @@ RandomX_ConfigurationScala::RandomX_ConfigurationScala()
 
 	RANDOMX_FREQ_IADD_RS = 25;
 	RANDOMX_FREQ_CBRANCH = 16;
+
+	DatasetInitAVX2_Supported = false;
 }
 
 RandomX_ConfigurationBase::RandomX_ConfigurationBase()
@@ -164,6 +167,7 @@ RandomX_ConfigurationBase::RandomX_ConfigurationBase()
 	, RANDOMX_FREQ_CFROUND(1)
 	, RANDOMX_FREQ_ISTORE(16)
 	, RANDOMX_FREQ_NOP(0)
+	, DatasetInitAVX2_Supported(true)
 {
 	fillAes4Rx4_Key[0] = rx_set_int_vec_i128(0x99e5d23f, 0x2f546d2b, 0xd1833ddb, 0x6421aadd);
 	fillAes4Rx4_Key[1] = rx_set_int_vec_i128(0xa5dfcde5, 0x06f79d53, 0xb6913f55, 0xb20e3450);
@@ -227,6 +231,34 @@ void randomx_set_scratchpad_prefetch_mode(int mode)
 	scratchpadPrefetchMode = mode;
 }
 
+static int datasetPrefetchMode = -1;
+
+void randomx_set_dataset_prefetch_mode(int mode)
+{
+	datasetPrefetchMode = mode;
+}
+
+static thread_local xmrig::RxPhaseGate *phaseGate = nullptr;
+
+void randomx_set_phase_gate(xmrig::RxPhaseGate *gate)
+{
+	phaseGate = gate;
+}
+
+static const yespower_params_t yespowerParams = { YESPOWER_1_0, 2048, 8, NULL, 0 };
+static thread_local yespower_local_t yespowerLocal = { NULL, NULL, 0, 0 };
+
+size_t randomx_yespower_memory_size()
+{
+	return yespower_local_size(&yespowerParams);
+}
+
+void randomx_set_yespower_memory(uint8_t *memory, size_t size)
+{
+	yespower_free_local(&yespowerLocal);
+	yespower_init_local_region(&yespowerLocal, memory, size);
+}
+
 void RandomX_ConfigurationBase::Apply()
 {
 	const uint32_t ScratchpadL1Mask_Calculated = (ScratchpadL1_Size / sizeof(uint64_t) - 1) * 8;
@@ -284,11 +316,49 @@ void RandomX_ConfigurationBase::Apply()
 		}
 	}
 
+	// Apply dataset prefetch mode
+	{
+		uint32_t* a = (uint32_t*)(codeReadDatasetTweaked + 11);
+		uint32_t* b = (uint32_t*)(codeReadDatasetRyzenTweaked + 28);
+
+		// The next dataset line is known only one iteration ahead, so the hint is all there is to tune.
+		// Auto keeps the upstream prefetchnta, other hints are opt-in until they are measured per CPU.
+		const int mode = datasetPrefetchMode < 0 ? 2 : datasetPrefetchMode;
+
+		uint32_t value;
+		switch (mode)
+		{
+		case 0:
+			value = 0x00401F0FUL; // 4-byte nop
+			break;
+
+		case 1:
+			value = 0x170C180FUL; // prefetcht0 [rdi+rdx]
+			break;
+
+		case 2:
+		default:
+			value = 0x1704180FUL; // prefetchnta [rdi+rdx]
+			break;
+
+		case 3:
+			value = 0x1714180FUL; // prefetcht1 [rdi+rdx]
+			break;
+
+		case 4:
+			value = 0x171C180FUL; // prefetcht2 [rdi+rdx]
+			break;
+		}
+
+		*a = value;
+		*b = value;
+	}
+
 typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx::Instruction&);
 
 #define JIT_HANDLE(x, prev) do { \
 		const InstructionGeneratorX86_2 p = &randomx::JitCompilerX86::h_##x; \
-		memcpy(randomx::JitCompilerX86::engine + k, &p, sizeof(p)); \
+		memcpy(JitEngine + k, &p, sizeof(JitEngine[0])); \
 	} while (0)
 
 #elif defined(XMRIG_ARMv8)
@@ -299,7 +369,7 @@ typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx
 	Log2_DatasetBaseSize = Log2(DatasetBaseSize);
 	Log2_CacheSize = Log2((ArgonMemory * randomx::ArgonBlockSize) / randomx::CacheLineSize);
 
-#define JIT_HANDLE(x, prev) randomx::JitCompilerA64::engine[k] = &randomx::JitCompilerA64::h_##x
+#define JIT_HANDLE(x, prev) JitEngine[k] = &randomx::JitCompilerA64::h_##x
 
 #else
 #define JIT_HANDLE(x, prev)
@@ -387,15 +457,21 @@ RandomX_ConfigurationSafex RandomX_SafexConfig;
 RandomX_ConfigurationKeva RandomX_KevaConfig;
 RandomX_ConfigurationScala RandomX_ScalaConfig;
 
-alignas(64) RandomX_ConfigurationBase RandomX_CurrentConfig;
+alignas(64) RandomX_ConfigurationBase RandomX_DefaultConfig;
+thread_local const RandomX_ConfigurationBase *RandomX_ThreadConfig = &RandomX_DefaultConfig;
 
 static std::mutex vm_pool_mutex;
 
 int rx_yespower_k12(void *out, size_t outlen, const void *in, size_t inlen)
 {
 	rx_blake2b_wrapper::run(out, outlen, in, inlen);
-	yespower_params_t params = { YESPOWER_1_0, 2048, 8, NULL };
-	if (yespower_tls((const uint8_t *)out, outlen, &params, (yespower_binary_t *)out)) return -1;
+	// Memory of the calling worker if it provided one, otherwise an allocation of this thread.
+	if (yespowerLocal.aligned_size >= randomx_yespower_memory_size()) {
+		yespower_1_0_2048_8(yespowerLocal.aligned, (const uint8_t *)out, outlen, (yespower_binary_t *)out);
+	}
+	else if (yespower_tls((const uint8_t *)out, outlen, &yespowerParams, (yespower_binary_t *)out)) {
+		return -1;
+	}
 	return KangarooTwelve((const unsigned char *)out, outlen, (unsigned char *)out, 32, 0, 0);
 }
 
@@ -410,6 +486,8 @@ extern "C" {
 
 		try {
 			cache = new randomx_cache();
+			cache->variantConfig = &RandomX_CurrentConfig;
+
 			switch (flags & RANDOMX_FLAG_JIT) {
 				case RANDOMX_FLAG_DEFAULT:
 					cache->jit          = nullptr;
@@ -442,6 +520,7 @@ extern "C" {
 	void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize) {
 		assert(cache != nullptr);
 		assert(keySize == 0 || key != nullptr);
+		RandomX_ConfigScope scope(cache->variantConfig);
 		cache->initialize(cache, key, keySize);
 	}
 
@@ -469,6 +548,7 @@ extern "C" {
 	void randomx_init_dataset(randomx_dataset *dataset, randomx_cache *cache, unsigned long startItem, unsigned long itemCount) {
 		assert(dataset != nullptr);
 		assert(cache != nullptr);
+		RandomX_ConfigScope scope(cache->variantConfig);
 		assert(startItem < DatasetItemCount && itemCount <= DatasetItemCount);
 		assert(startItem + itemCount <= DatasetItemCount);
 		cache->datasetInit(cache, dataset->memory + startItem * randomx::CacheLineSize, startItem, startItem + itemCount);
@@ -506,6 +586,10 @@ extern "C" {
 			if (!vm_pool[node]) {
 				vm_pool[node] = (uint8_t*) rx_aligned_alloc(VM_POOL_SIZE, 4096);
 			}
+
+			if (!vm_pool[node]) {
+				return nullptr;
+			}
 		}
 
 
@@ -568,6 +652,7 @@ extern "C" {
 
 			vm->setScratchpad(scratchpad);
 			vm->setFlags(flags);
+			vm->setVariantConfig(&RandomX_CurrentConfig);
 		}
 		catch (std::exception &ex) {
 			vm = nullptr;
@@ -586,6 +671,7 @@ extern "C" {
 	void randomx_vm_set_cache(randomx_vm *machine, randomx_cache* cache) {
 		assert(machine != nullptr);
 		assert(cache != nullptr && cache->isInitialized());
+		RandomX_ConfigScope scope(machine->getVariantConfig());
 		machine->setCache(cache);
 	}
 
@@ -603,6 +689,7 @@ extern "C" {
 		assert(machine != nullptr);
 		assert(inputSize == 0 || input != nullptr);
 		assert(output != nullptr);
+		RandomX_ConfigScope scope(machine->getVariantConfig());
 		alignas(16) uint64_t tempHash[8];
                 switch (algo) {
                     case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), input, inputSize); break;
@@ -619,6 +706,7 @@ extern "C" {
 	}
 
 	void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize, const xmrig::Algorithm algo) {
+		RandomX_ConfigScope scope(machine->getVariantConfig());
                 switch (algo) {
                     case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), input, inputSize); break;
 		    default: rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
@@ -628,6 +716,7 @@ extern "C" {
 
 	void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output, const xmrig::Algorithm algo) {
 		PROFILE_SCOPE(RandomX_hash);
+		RandomX_ConfigScope scope(machine->getVariantConfig());
 
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
@@ -638,7 +727,16 @@ extern "C" {
 
 		// Finish current hash and fill the scratchpad for the next hash at the same time
                 switch (algo) {
-                    case xmrig::Algorithm::RX_XLA:   rx_yespower_k12(tempHash, sizeof(tempHash), nextInput, nextInputSize); break;
+                    case xmrig::Algorithm::RX_XLA:
+			if (phaseGate) {
+				phaseGate->enter();
+				rx_yespower_k12(tempHash, sizeof(tempHash), nextInput, nextInputSize);
+				phaseGate->leave();
+			}
+			else {
+				rx_yespower_k12(tempHash, sizeof(tempHash), nextInput, nextInputSize);
+			}
+			break;
 		    default: rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), nextInput, nextInputSize);
 		}
 		machine->hashAndFill(output, tempHash);
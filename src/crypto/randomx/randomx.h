@@ -35,6 +35,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "base/crypto/Algorithm.h"
 #include "crypto/randomx/intrin_portable.h"
 
+namespace xmrig { class RxPhaseGate; }
+
+namespace randomx {
+	class Instruction;
+
+#if defined(_M_X64) || defined(__x86_64__)
+	class JitCompilerX86;
+	typedef void(*InstructionGeneratorX86)(JitCompilerX86*, const Instruction&);
+#elif defined(XMRIG_ARMv8)
+	class JitCompilerA64;
+	typedef void(JitCompilerA64::*InstructionGeneratorA64)(Instruction&, uint32_t&);
+#endif
+}
+
 #define RANDOMX_HASH_SIZE 32
 #define RANDOMX_DATASET_ITEM_SIZE 64
 
@@ -133,6 +147,9 @@ struct RandomX_ConfigurationBase
 	uint8_t codeReadDatasetLightSshInitTweaked[68];
 	uint8_t codePrefetchScratchpadTweaked[32];
 
+	// The AVX2 dataset init code only handles the reference superscalar parameters.
+	bool DatasetInitAVX2_Supported;
+
         uint32_t CacheLineAlignMask_Calculated;
 
 	uint32_t AddressMask_Calculated[4];
@@ -146,6 +163,13 @@ struct RandomX_ConfigurationBase
 	uint32_t Log2_DatasetBaseSize;
 	uint32_t Log2_CacheSize;
 #endif
+
+	// JIT code generator of each opcode, filled by Apply() from the instruction frequencies.
+#if defined(_M_X64) || defined(__x86_64__)
+	randomx::InstructionGeneratorX86 JitEngine[256];
+#elif defined(XMRIG_ARMv8)
+	randomx::InstructionGeneratorA64 JitEngine[256];
+#endif
 };
 
 struct RandomX_ConfigurationMonero : public RandomX_ConfigurationBase {};
@@ -162,20 +186,46 @@ extern RandomX_ConfigurationSafex RandomX_SafexConfig;
 extern RandomX_ConfigurationKeva RandomX_KevaConfig;
 extern RandomX_ConfigurationScala RandomX_ScalaConfig;
 
-extern RandomX_ConfigurationBase RandomX_CurrentConfig;
+// Configuration set by randomx_apply_config(), used by every thread which hasn't selected another one.
+extern RandomX_ConfigurationBase RandomX_DefaultConfig;
+extern thread_local const RandomX_ConfigurationBase *RandomX_ThreadConfig;
+
+#define RandomX_CurrentConfig (*RandomX_ThreadConfig)
 
 template<typename T>
 void randomx_apply_config(const T& config)
 {
 	static_assert(sizeof(T) == sizeof(RandomX_ConfigurationBase), "Invalid RandomX configuration struct size");
 	static_assert(std::is_base_of<RandomX_ConfigurationBase, T>::value, "Incompatible RandomX configuration struct");
-	RandomX_CurrentConfig = config;
-	RandomX_CurrentConfig.Apply();
+	RandomX_DefaultConfig = config;
+	RandomX_DefaultConfig.Apply();
 }
 
+// Selects the configuration of the calling thread while in scope. Caches and VMs keep the configuration
+// they were created with, calls on them switch to it, so a private configuration only needs to be
+// selected while they are created.
+class RandomX_ConfigScope
+{
+public:
+	inline explicit RandomX_ConfigScope(const RandomX_ConfigurationBase *config) : m_prev(RandomX_ThreadConfig) { if (config) { RandomX_ThreadConfig = config; } }
+	inline ~RandomX_ConfigScope() { RandomX_ThreadConfig = m_prev; }
+
+	RandomX_ConfigScope(const RandomX_ConfigScope &) = delete;
+	RandomX_ConfigScope &operator=(const RandomX_ConfigScope &) = delete;
+
+private:
+	const RandomX_ConfigurationBase *m_prev;
+};
+
 void randomx_set_scratchpad_prefetch_mode(int mode);
+void randomx_set_dataset_prefetch_mode(int mode);
 void randomx_set_huge_pages_jit(bool hugePages);
 void randomx_set_optimized_dataset_init(int value);
+void randomx_set_jit_profile(int profile);
+void randomx_set_shared_jit_code(bool shared);
+void randomx_set_phase_gate(xmrig::RxPhaseGate *gate);
+size_t randomx_yespower_memory_size();
+void randomx_set_yespower_memory(uint8_t *memory, size_t size);
 
 #if defined(__cplusplus)
 extern "C" {
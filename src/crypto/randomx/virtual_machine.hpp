@@ -49,6 +49,9 @@ public:
 	void setFlags(uint32_t flags) { vm_flags = flags; }
 	uint32_t getFlags() const { return vm_flags; }
 
+	void setVariantConfig(const RandomX_ConfigurationBase* cfg) { variantConfig = cfg; }
+	const RandomX_ConfigurationBase* getVariantConfig() const { return variantConfig; }
+
 	randomx::RegisterFile *getRegisterFile() {
 		return &reg;
 	}
@@ -75,6 +78,7 @@ protected:
 	};
 	uint64_t datasetOffset;
 	uint32_t vm_flags;
+	const RandomX_ConfigurationBase* variantConfig = nullptr;
 };
 
 namespace randomx {
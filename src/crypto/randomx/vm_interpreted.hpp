@@ -62,7 +62,7 @@ namespace randomx {
 	private:
 		void execute();
 
-		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE];
+		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE + 1];
 	};
 
 	using InterpretedVmDefault = InterpretedVm<1>;
@@ -48,6 +48,11 @@ namespace randomx {
 			r[q] ^= rl[q];
 	}
 
+	template<int softAes>
+	void InterpretedLightVm<softAes>::datasetPrefetch(uint64_t address) {
+		prefetchDatasetItem(cachePtr, address / CacheLineSize);
+	}
+
 	template class InterpretedLightVm<false>;
 	template class InterpretedLightVm<true>;
 }
@@ -47,7 +47,7 @@ namespace randomx {
 
 	protected:
 		void datasetRead(uint64_t address, int_reg_t(&r)[8]) override;
-		void datasetPrefetch(uint64_t address) override { }
+		void datasetPrefetch(uint64_t address) override;
 	};
 
 	using InterpretedLightVmDefault = InterpretedLightVm<1>;
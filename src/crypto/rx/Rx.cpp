@@ -61,9 +61,15 @@ xmrig::HugePagesInfo xmrig::Rx::hugePages()
 }
 
 
-xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
+xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId, int64_t affinity)
 {
-    return d_ptr->queue.dataset(job, nodeId);
+    return d_ptr->queue.dataset(job, nodeId, affinity);
+}
+
+
+std::pair<uint64_t, uint64_t> xmrig::Rx::seedCache()
+{
+    return d_ptr->queue.seedCache();
 }
 
 
@@ -88,7 +94,6 @@ void xmrig::Rx::init(IRxListener *listener)
 template<typename T>
 bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu)
 {
-    const Algorithm algo = seed.algorithm();
     if (seed.algorithm().family() != Algorithm::RANDOM_X) {
 #       ifdef XMRIG_FEATURE_MSR
         RxMsr::destroy();
@@ -98,8 +103,10 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     }
 
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
+    randomx_set_dataset_prefetch_mode(config.datasetPrefetchMode());
+    randomx_set_jit_profile(config.jitProfile());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
-    randomx_set_optimized_dataset_init(algo != Algorithm::RX_XLA ? config.initDatasetAVX2() : 0);
+    randomx_set_optimized_dataset_init(config.initDatasetAVX2());
 
 #   ifdef XMRIG_FEATURE_MSR
     if (!RxMsr::isInitialized()) {
@@ -122,7 +129,7 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         return true;
     }
 
-    d_ptr->queue.enqueue(seed, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
+    d_ptr->queue.enqueue(seed, config.nodeset(), config.isL3Replicas(), config.seedCache(), config.seedCacheMemory(), config.sharedDataset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
 
     return false;
 }
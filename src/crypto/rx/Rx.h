@@ -46,7 +46,8 @@ class Rx
 {
 public:
     static HugePagesInfo hugePages();
-    static RxDataset *dataset(const Job &job, uint32_t nodeId);
+    static RxDataset *dataset(const Job &job, uint32_t nodeId, int64_t affinity = -1);
+    static std::pair<uint64_t, uint64_t> seedCache();
     static void destroy();
     static void init(IRxListener *listener);
     template<typename T> static bool init(const T &seed, const RxConfig &config, const CpuConfig &cpu);
@@ -29,6 +29,11 @@
 #include "crypto/rx/RxSeed.h"
 
 
+#include <algorithm>
+#include <uv.h>
+#include <vector>
+
+
 namespace xmrig {
 
 
@@ -40,73 +45,181 @@ class RxBasicStoragePrivate
 public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStoragePrivate)
 
-    inline RxBasicStoragePrivate() = default;
-    inline ~RxBasicStoragePrivate() { deleteDataset(); }
+    inline RxBasicStoragePrivate(uint32_t seeds, uint32_t memory) : m_memory(memory * oneMiB), m_seeds(std::max(seeds, 1U)) {}
+
+    inline ~RxBasicStoragePrivate()
+    {
+        for (auto &entry : m_entries) {
+            delete entry.dataset;
+        }
+    }
 
-    inline bool isReady(const Job &job) const   { return m_ready && m_seed == job; }
-    inline RxDataset *dataset() const           { return m_dataset; }
-    inline void deleteDataset()                 { delete m_dataset; m_dataset = nullptr; }
+    inline RxDataset *current() const           { return m_entries.empty() ? nullptr : m_entries.front().dataset; }
 
 
-    inline void setSeed(const RxSeed &seed)
+    inline RxDataset *dataset(const Job &job) const
     {
-        m_ready = false;
+        for (const auto &entry : m_entries) {
+            if (entry.ready && entry.seed == job) {
+                return entry.dataset;
+            }
+        }
+
+        return nullptr;
+    }
 
-        if (m_seed.algorithm() != seed.algorithm()) {
-            RxAlgo::apply(seed.algorithm());
+
+    inline HugePagesInfo hugePages() const
+    {
+        HugePagesInfo pages;
+
+        for (const auto &entry : m_entries) {
+            pages += entry.dataset->hugePages();
         }
 
-        m_seed = seed;
+        return pages;
     }
 
 
-    inline bool createDataset(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
+    // Makes an already initialized seed the most recently used one.
+    inline bool select(const RxSeed &seed)
     {
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->ready && it->seed == seed) {
+                std::rotate(m_entries.begin(), it, it + 1);
+                applyAlgorithm(seed.algorithm());
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    inline void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+    {
+        // RandomX memory is sized by the current configuration, so the algorithm must be applied before allocation.
+        applyAlgorithm(seed.algorithm());
+
+        if (!canGrow() || !createDataset(hugePages, oneGbPages, mode)) {
+            if (m_entries.empty()) {
+                return;
+            }
+
+            // Reuse memory of the least recently used seed.
+            std::rotate(m_entries.begin(), m_entries.end() - 1, m_entries.end());
+
+            if (!m_entries.front().dataset->isSized()) {
+                delete m_entries.front().dataset;
+                m_entries.erase(m_entries.begin());
+
+                if (!createDataset(hugePages, oneGbPages, mode)) {
+                    return;
+                }
+            }
+        }
+
+        Entry &entry = m_entries.front();
+        entry.ready  = false;
+        entry.seed   = seed;
+
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
-        if (!m_dataset->cache()->get()) {
-            deleteDataset();
+        entry.ready = entry.dataset->init(seed.data(), threads, priority);
+
+        if (entry.ready) {
+            LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+        }
+    }
+
+
+private:
+    struct Entry
+    {
+        bool ready;
+        RxDataset *dataset;
+        RxSeed seed;
+    };
 
-            LOG_INFO("%s" RED_BOLD("failed to allocate RandomX memory") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
 
+    inline void applyAlgorithm(const Algorithm &algorithm)
+    {
+        if (m_algorithm != algorithm) {
+            RxAlgo::apply(algorithm);
+            m_algorithm = algorithm;
+        }
+    }
+
+
+    // An extra seed is kept only within the memory budget, or if no budget is set, while at least twice its size is still free.
+    inline bool canGrow() const
+    {
+        if (m_entries.empty()) {
+            return true;
+        }
+
+        if (m_entries.size() >= m_seeds) {
             return false;
         }
 
-        printAllocStatus(ts);
+        const size_t size = RxDataset::requiredSize() + RxCache::requiredSize();
+        if (m_memory) {
+            size_t used = 0;
+            for (const auto &entry : m_entries) {
+                used += entry.dataset->size();
+            }
 
-        return true;
+            return used + size <= m_memory;
+        }
+
+        return uv_get_free_memory() >= size * 2;
     }
 
 
-    inline void initDataset(uint32_t threads, int priority)
+    inline bool createDataset(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
     {
         const uint64_t ts = Chrono::steadyMSecs();
+        auto dataset      = new RxDataset(hugePages, oneGbPages, true, mode, 0);
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        if (!dataset->cache()->get()) {
+            delete dataset;
 
-        if (m_ready) {
-            LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+            LOG_INFO("%s" RED_BOLD("failed to allocate RandomX memory") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+            return false;
         }
+
+        // Don't let an extra seed drop mining to the slow mode, reuse an older seed instead.
+        if (!m_entries.empty() && m_entries.front().dataset->get() && !dataset->get()) {
+            delete dataset;
+
+            return false;
+        }
+
+        m_entries.insert(m_entries.begin(), Entry{ false, dataset, RxSeed() });
+
+        printAllocStatus(dataset, ts);
+
+        return true;
     }
 
 
-private:
-    void printAllocStatus(uint64_t ts)
+    void printAllocStatus(RxDataset *dataset, uint64_t ts)
     {
-        if (m_dataset->get() != nullptr) {
-            const auto pages = m_dataset->hugePages();
+        if (dataset->get() != nullptr) {
+            const auto pages = dataset->hugePages();
 
             LOG_INFO("%s" GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") BLACK_BOLD(" (%zu+%zu)") " huge pages %s%1.0f%% %u/%u" CLEAR " %sJIT" BLACK_BOLD(" (%" PRIu64 " ms)"),
                      Tags::randomx(),
                      pages.size / oneMiB,
-                     RxDataset::maxSize() / oneMiB,
-                     RxCache::maxSize() / oneMiB,
+                     dataset->size(false) / oneMiB,
+                     dataset->cache()->size() / oneMiB,
                      (pages.isFullyAllocated() ? GREEN_BOLD_S : (pages.allocated == 0 ? RED_BOLD_S : YELLOW_BOLD_S)),
                      pages.percent(),
                      pages.allocated,
                      pages.total,
-                     m_dataset->cache()->isJIT() ? GREEN_BOLD_S "+" : RED_BOLD_S "-",
+                     dataset->cache()->isJIT() ? GREEN_BOLD_S "+" : RED_BOLD_S "-",
                      Chrono::steadyMSecs() - ts
                      );
         }
@@ -116,17 +229,18 @@ private:
     }
 
 
-    bool m_ready         = false;
-    RxDataset *m_dataset = nullptr;
-    RxSeed m_seed;
+    Algorithm m_algorithm;
+    const size_t m_memory;
+    const uint32_t m_seeds;
+    std::vector<Entry> m_entries;
 };
 
 
 } // namespace xmrig
 
 
-xmrig::RxBasicStorage::RxBasicStorage() :
-    d_ptr(new RxBasicStoragePrivate())
+xmrig::RxBasicStorage::RxBasicStorage(uint32_t seeds, uint32_t memory) :
+    d_ptr(new RxBasicStoragePrivate(seeds, memory))
 {
 }
 
@@ -139,37 +253,29 @@ xmrig::RxBasicStorage::~RxBasicStorage()
 
 bool xmrig::RxBasicStorage::isAllocated() const
 {
-    return d_ptr->dataset() && d_ptr->dataset()->cache() && d_ptr->dataset()->cache()->get();
+    return d_ptr->current() && d_ptr->current()->cache() && d_ptr->current()->cache()->get();
 }
 
 
-xmrig::HugePagesInfo xmrig::RxBasicStorage::hugePages() const
+bool xmrig::RxBasicStorage::select(const RxSeed &seed)
 {
-    if (!d_ptr->dataset()) {
-        return {};
-    }
-
-    return d_ptr->dataset()->hugePages();
+    return d_ptr->select(seed);
 }
 
 
-xmrig::RxDataset *xmrig::RxBasicStorage::dataset(const Job &job, uint32_t) const
+xmrig::HugePagesInfo xmrig::RxBasicStorage::hugePages() const
 {
-    if (!d_ptr->isReady(job)) {
-        return nullptr;
-    }
-
-    return d_ptr->dataset();
+    return d_ptr->hugePages();
 }
 
 
-void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+xmrig::RxDataset *xmrig::RxBasicStorage::dataset(const Job &job, uint32_t, int64_t) const
 {
-    d_ptr->setSeed(seed);
+    return d_ptr->dataset(job);
+}
 
-    if (!d_ptr->dataset() && !d_ptr->createDataset(hugePages, oneGbPages, mode)) {
-        return;
-    }
 
-    d_ptr->initDataset(threads, priority);
+void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+{
+    d_ptr->init(seed, threads, hugePages, oneGbPages, mode, priority);
 }
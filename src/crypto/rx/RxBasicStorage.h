@@ -36,13 +36,14 @@ class RxBasicStorage : public IRxStorage
 public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStorage);
 
-    RxBasicStorage();
+    RxBasicStorage(uint32_t seeds = 1, uint32_t memory = 0);
     ~RxBasicStorage() override;
 
 protected:
     bool isAllocated() const override;
+    bool select(const RxSeed &seed) override;
     HugePagesInfo hugePages() const override;
-    RxDataset *dataset(const Job &job, uint32_t nodeId) const override;
+    RxDataset *dataset(const Job &job, uint32_t nodeId, int64_t affinity) const override;
     void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
 
 private:
@@ -27,21 +27,24 @@
 
 #include "crypto/rx/RxCache.h"
 #include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/common.hpp"
 #include "crypto/randomx/randomx.h"
 
 
 static_assert(RANDOMX_FLAG_JIT == 8, "RANDOMX_FLAG_JIT flag mismatch");
 
 
-xmrig::RxCache::RxCache(bool hugePages, uint32_t nodeId)
+xmrig::RxCache::RxCache(bool hugePages, uint32_t nodeId) :
+    m_size(requiredSize())
 {
-    m_memory = new VirtualMemory(maxSize(), hugePages, false, false, nodeId);
+    m_memory = new VirtualMemory(m_size, hugePages, false, false, nodeId);
 
     create(m_memory->raw());
 }
 
 
-xmrig::RxCache::RxCache(uint8_t *memory)
+xmrig::RxCache::RxCache(uint8_t *memory) :
+    m_size(requiredSize())
 {
     create(memory);
 }
@@ -73,6 +76,12 @@ bool xmrig::RxCache::init(const Buffer &seed)
 }
 
 
+size_t xmrig::RxCache::requiredSize()
+{
+    return static_cast<size_t>(RandomX_CurrentConfig.ArgonMemory) * randomx::ArgonBlockSize;
+}
+
+
 xmrig::HugePagesInfo xmrig::RxCache::hugePages() const
 {
     return m_memory ? m_memory->hugePages() : HugePagesInfo();
@@ -56,11 +56,13 @@ public:
     inline bool isJIT() const               { return m_jit; }
     inline const Buffer &seed() const       { return m_seed; }
     inline randomx_cache *get() const       { return m_cache; }
-    inline size_t size() const              { return maxSize(); }
+    inline size_t size() const              { return m_size; }
 
     bool init(const Buffer &seed);
     HugePagesInfo hugePages() const;
 
+    static size_t requiredSize();
+
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
 
 private:
@@ -69,6 +71,7 @@ private:
     bool m_jit              = true;
     Buffer m_seed;
     randomx_cache *m_cache  = nullptr;
+    const size_t m_size;
     VirtualMemory *m_memory = nullptr;
 };
 
@@ -47,7 +47,9 @@
 namespace xmrig {
 
 const char *RxConfig::kInit                     = "init";
+const char *RxConfig::kDatasetPrefetchMode      = "dataset_prefetch_mode";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
+const char *RxConfig::kJitProfile               = "jit_profile";
 const char *RxConfig::kField                    = "randomx";
 const char *RxConfig::kMode                     = "mode";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
@@ -55,13 +57,18 @@ const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kSeedCache                = "seed_cache";
+const char *RxConfig::kSeedCacheMemory          = "seed_cache_memory";
+const char *RxConfig::kSharedDataset            = "shared_dataset";
 
 #ifdef XMRIG_FEATURE_HWLOC
+const char *RxConfig::kL3Replicas               = "l3_replicas";
 const char *RxConfig::kNUMA                     = "numa";
 #endif
 
 
 static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "fast", "light" };
+static const std::array<const char *, RxConfig::JitProfileMax> jitProfileNames = { "auto", "generic", "intel", "zen" };
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -90,7 +97,10 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         m_threads         = Json::getInt(value, kInit, m_threads);
         m_initDatasetAVX2 = Json::getInt(value, kInitAVX2, m_initDatasetAVX2);
         m_mode            = readMode(Json::getValue(value, kMode));
+        m_jitProfile      = readJitProfile(Json::getValue(value, kJitProfile));
         m_rdmsr           = Json::getBool(value, kRdmsr, m_rdmsr);
+        m_seedCache       = std::max(Json::getUint(value, kSeedCache, m_seedCache), 1U);
+        m_seedCacheMemory = Json::getUint(value, kSeedCacheMemory, m_seedCacheMemory);
 
 #       ifdef XMRIG_FEATURE_MSR
         readMSR(Json::getValue(value, kWrmsr));
@@ -99,16 +109,20 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
 
 #       ifdef XMRIG_OS_LINUX
-        m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
+        m_oneGbPages    = Json::getBool(value, kOneGbPages, m_oneGbPages);
+        m_sharedDataset = Json::getString(value, kSharedDataset);
 #       endif
 
 #       ifdef XMRIG_FEATURE_HWLOC
         if (m_mode == LightMode) {
-            m_numa = false;
+            m_numa       = false;
+            m_l3Replicas = false;
 
             return true;
         }
 
+        m_l3Replicas = Json::getBool(value, kL3Replicas, m_l3Replicas);
+
         const auto &numa = Json::getValue(value, kNUMA);
         if (numa.IsArray()) {
             m_nodeset.reserve(numa.Size());
@@ -129,6 +143,11 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
             m_scratchpadPrefetchMode = static_cast<ScratchpadPrefetchMode>(mode);
         }
 
+        const int datasetMode = Json::getInt(value, kDatasetPrefetchMode, m_datasetPrefetchMode);
+        if (datasetMode >= DatasetPrefetchAuto && datasetMode < DatasetPrefetchMax) {
+            m_datasetPrefetchMode = static_cast<DatasetPrefetchMode>(datasetMode);
+        }
+
         return true;
     }
 
@@ -181,9 +200,16 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
     else {
         obj.AddMember(StringRef(kNUMA), m_numa, allocator);
     }
+
+    obj.AddMember(StringRef(kL3Replicas), m_l3Replicas, allocator);
 #   endif
 
     obj.AddMember(StringRef(kScratchpadPrefetchMode), static_cast<int>(m_scratchpadPrefetchMode), allocator);
+    obj.AddMember(StringRef(kDatasetPrefetchMode), static_cast<int>(m_datasetPrefetchMode), allocator);
+    obj.AddMember(StringRef(kJitProfile),   StringRef(jitProfileName()), allocator);
+    obj.AddMember(StringRef(kSeedCache),        m_seedCache, allocator);
+    obj.AddMember(StringRef(kSeedCacheMemory),  m_seedCacheMemory, allocator);
+    obj.AddMember(StringRef(kSharedDataset),    m_sharedDataset.toJSON(), allocator);
 
     return obj;
 }
@@ -201,6 +227,12 @@ std::vector<uint32_t> xmrig::RxConfig::nodeset() const
 #endif
 
 
+const char *xmrig::RxConfig::jitProfileName() const
+{
+    return jitProfileNames[m_jitProfile];
+}
+
+
 const char *xmrig::RxConfig::modeName() const
 {
     return modeNames[m_mode];
@@ -304,3 +336,23 @@ xmrig::RxConfig::Mode xmrig::RxConfig::readMode(const rapidjson::Value &value) c
 
     return AutoMode;
 }
+
+
+xmrig::RxConfig::JitProfile xmrig::RxConfig::readJitProfile(const rapidjson::Value &value) const
+{
+    if (value.IsUint()) {
+        return static_cast<JitProfile>(std::min(value.GetUint(), JitProfileMax - 1));
+    }
+
+    if (value.IsString()) {
+        auto profile = value.GetString();
+
+        for (size_t i = 0; i < jitProfileNames.size(); i++) {
+            if (strcasecmp(profile, jitProfileNames[i]) == 0) {
+                return static_cast<JitProfile>(i);
+            }
+        }
+    }
+
+    return JitProfileAuto;
+}
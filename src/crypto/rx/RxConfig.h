@@ -27,6 +27,7 @@
 
 
 #include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -58,17 +59,41 @@ public:
         ScratchpadPrefetchMax,
     };
 
+    enum DatasetPrefetchMode : int {
+        DatasetPrefetchAuto = -1,
+        DatasetPrefetchOff,
+        DatasetPrefetchT0,
+        DatasetPrefetchNTA,
+        DatasetPrefetchT1,
+        DatasetPrefetchT2,
+        DatasetPrefetchMax
+    };
+
+    enum JitProfile : uint32_t {
+        JitProfileAuto,
+        JitProfileGeneric,
+        JitProfileIntel,
+        JitProfileZen,
+        JitProfileMax
+    };
+
     static const char *kCacheQoS;
+    static const char *kDatasetPrefetchMode;
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
+    static const char *kJitProfile;
     static const char *kMode;
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
+    static const char *kSeedCache;
+    static const char *kSeedCacheMemory;
+    static const char *kSharedDataset;
     static const char *kWrmsr;
 
 #   ifdef XMRIG_FEATURE_HWLOC
+    static const char *kL3Replicas;
     static const char *kNUMA;
 #   endif
 
@@ -77,10 +102,13 @@ public:
 
 #   ifdef XMRIG_FEATURE_HWLOC
     std::vector<uint32_t> nodeset() const;
+    inline bool isL3Replicas() const             { return m_l3Replicas; }
 #   else
     inline std::vector<uint32_t> nodeset() const { return std::vector<uint32_t>(); }
+    inline constexpr bool isL3Replicas() const   { return false; }
 #   endif
 
+    const char *jitProfileName() const;
     const char *modeName() const;
     uint32_t threads(uint32_t limit = 100) const;
 
@@ -90,8 +118,13 @@ public:
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
     inline Mode mode() const            { return m_mode; }
+    inline JitProfile jitProfile() const { return m_jitProfile; }
+    inline const String &sharedDataset() const { return m_sharedDataset; }
 
+    inline DatasetPrefetchMode datasetPrefetchMode() const       { return m_datasetPrefetchMode; }
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
+    inline uint32_t seedCache() const                            { return m_seedCache; }
+    inline uint32_t seedCacheMemory() const                      { return m_seedCacheMemory; }
 
 #   ifdef XMRIG_FEATURE_MSR
     const char *msrPresetName() const;
@@ -111,6 +144,7 @@ private:
 
     bool m_cacheQoS = false;
 
+    JitProfile readJitProfile(const rapidjson::Value &value) const;
     Mode readMode(const rapidjson::Value &value) const;
 
     bool m_oneGbPages     = false;
@@ -118,10 +152,16 @@ private:
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
     Mode m_mode           = AutoMode;
+    JitProfile m_jitProfile = JitProfileAuto;
+    String m_sharedDataset;
 
+    DatasetPrefetchMode m_datasetPrefetchMode       = DatasetPrefetchAuto;
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
+    uint32_t m_seedCache                            = 1;
+    uint32_t m_seedCacheMemory                      = 0;
 
 #   ifdef XMRIG_FEATURE_HWLOC
+    bool m_l3Replicas     = false;
     bool m_numa           = true;
     std::vector<uint32_t> m_nodeset;
 #   endif
@@ -22,6 +22,7 @@
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Cgroup.h"
 #include "base/kernel/Platform.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
@@ -30,7 +31,6 @@
 
 
 #include <thread>
-#include <uv.h>
 
 
 namespace xmrig {
@@ -60,7 +60,7 @@ xmrig::RxDataset::RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfi
     allocate(hugePages, oneGbPages);
 
     if (isOneGbPages()) {
-        m_cache = new RxCache(m_memory->raw() + VirtualMemory::align(maxSize()));
+        m_cache = new RxCache(m_memory->raw() + VirtualMemory::align(m_size));
 
         return;
     }
@@ -78,6 +78,16 @@ xmrig::RxDataset::RxDataset(RxCache *cache) :
 }
 
 
+// Dataset in memory owned by the caller, for example a shared mapping.
+xmrig::RxDataset::RxDataset(uint8_t *memory, RxCache *cache) :
+    m_node(0),
+    m_dataset(randomx_create_dataset(memory)),
+    m_cache(cache),
+    m_size(requiredSize())
+{
+}
+
+
 xmrig::RxDataset::~RxDataset()
 {
     randomx_release_dataset(m_dataset);
@@ -135,6 +145,13 @@ bool xmrig::RxDataset::isOneGbPages() const
 }
 
 
+// Memory of another RandomX configuration can't be reused for a seed of the applied one.
+bool xmrig::RxDataset::isSized() const
+{
+    return (!m_dataset || m_size == requiredSize()) && (!m_cache || m_cache->size() == RxCache::requiredSize());
+}
+
+
 xmrig::HugePagesInfo xmrig::RxDataset::hugePages(bool cache) const
 {
     auto pages = m_memory ? m_memory->hugePages() : HugePagesInfo();
@@ -152,11 +169,11 @@ size_t xmrig::RxDataset::size(bool cache) const
     size_t size = 0;
 
     if (m_dataset) {
-        size += maxSize();
+        size += m_size;
     }
 
     if (cache && m_cache) {
-        size += RxCache::maxSize();
+        size += m_cache->size();
     }
 
     return size;
@@ -179,6 +196,12 @@ uint8_t *xmrig::RxDataset::tryAllocateScrathpad()
 }
 
 
+size_t xmrig::RxDataset::requiredSize()
+{
+    return randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE;
+}
+
+
 void *xmrig::RxDataset::raw() const
 {
     return m_dataset ? randomx_get_dataset_memory(m_dataset) : nullptr;
@@ -191,7 +214,7 @@ void xmrig::RxDataset::setRaw(const void *raw)
         return;
     }
 
-    volatile size_t N = maxSize();
+    volatile size_t N = m_size;
     memcpy(randomx_get_dataset_memory(m_dataset), raw, N);
 }
 
@@ -204,16 +227,18 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
         return;
     }
 
-    if (m_mode == RxConfig::AutoMode && uv_get_total_memory() < (maxSize() + RxCache::maxSize())) {
+    if (m_mode == RxConfig::AutoMode && Cgroup::totalMemory() < (requiredSize() + RxCache::requiredSize())) {
         LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX dataset", Tags::randomx());
 
         return;
     }
 
-    m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node);
+    m_size    = requiredSize();
+    m_memory  = new VirtualMemory(m_size, hugePages, oneGbPages, false, m_node);
 
+    // The cache and scratchpads are packed into the rest of the 1 GB pages.
     if (m_memory->isOneGbPages()) {
-        m_scratchpadOffset = maxSize() + RANDOMX_CACHE_MAX_SIZE;
+        m_scratchpadOffset = VirtualMemory::align(m_size) + RxCache::requiredSize();
         m_scratchpadLimit = m_memory->capacity();
     }
 
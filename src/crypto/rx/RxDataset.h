@@ -48,6 +48,7 @@ public:
 
     RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node);
     RxDataset(RxCache *cache);
+    RxDataset(uint8_t *memory, RxCache *cache);
     ~RxDataset();
 
     inline randomx_dataset *get() const     { return m_dataset; }
@@ -57,12 +58,15 @@ public:
     bool init(const Buffer &seed, uint32_t numThreads, int priority);
     bool isHugePages() const;
     bool isOneGbPages() const;
+    bool isSized() const;
     HugePagesInfo hugePages(bool cache = true) const;
     size_t size(bool cache = true) const;
     uint8_t *tryAllocateScrathpad();
     void *raw() const;
     void setRaw(const void *raw);
 
+    static size_t requiredSize();
+
     static inline constexpr size_t maxSize() { return RANDOMX_DATASET_MAX_SIZE; }
 
 private:
@@ -73,6 +77,7 @@ private:
     randomx_dataset *m_dataset  = nullptr;
     RxCache *m_cache            = nullptr;
     size_t m_scratchpadLimit    = 0;
+    size_t m_size               = 0;
     std::atomic<size_t> m_scratchpadOffset{};
     VirtualMemory *m_memory     = nullptr;
 };
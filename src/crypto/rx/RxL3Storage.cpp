@@ -0,0 +1,474 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxL3Storage.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/platform/HwlocCpuInfo.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
+#include "base/tools/Chrono.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <hwloc.h>
+#include <thread>
+
+
+namespace xmrig {
+
+
+constexpr size_t oneMiB = 1024 * 1024;
+static std::mutex mutex;
+
+
+static inline bool isL3Cache(hwloc_obj_t obj)
+{
+#   if HWLOC_API_VERSION >= 0x20000
+    return obj->type == HWLOC_OBJ_L3CACHE;
+#   else
+    return obj->type == HWLOC_OBJ_CACHE && obj->attr->cache.depth == 3;
+#   endif
+}
+
+
+// L3 caches in the order of the first PU they contain.
+static std::vector<hwloc_obj_t> l3Domains()
+{
+    std::vector<hwloc_obj_t> out;
+
+    auto topology   = static_cast<HwlocCpuInfo *>(Cpu::info())->topology();
+    const int count = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PU);
+
+    for (int i = 0; i < count; ++i) {
+        hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_PU, static_cast<unsigned>(i));
+
+        while (obj && !isL3Cache(obj)) {
+            obj = obj->parent;
+        }
+
+        if (obj && std::find(out.begin(), out.end(), obj) == out.end()) {
+            out.emplace_back(obj);
+        }
+    }
+
+    return out;
+}
+
+
+static inline uint32_t nodeOf(hwloc_obj_t cache)
+{
+    const int node = cache->nodeset ? hwloc_bitmap_first(cache->nodeset) : -1;
+
+    return node > 0 ? static_cast<uint32_t>(node) : 0;
+}
+
+
+static bool bindToL3(hwloc_obj_t cache)
+{
+    auto cpu = static_cast<HwlocCpuInfo *>(Cpu::info());
+
+    Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(cache->cpuset)));
+
+    return Cpu::info()->nodes() < 2 || (cache->nodeset && cpu->membind(cache->nodeset));
+}
+
+
+static inline void printSkipped(uint32_t id, const char *reason)
+{
+    LOG_WARN("%s" CYAN_BOLD("L3#%u ") RED_BOLD("skipped") YELLOW(" (%s)"), Tags::randomx(), id, reason);
+}
+
+
+static inline void printDatasetReady(uint32_t id, uint64_t ts)
+{
+    LOG_INFO("%s" CYAN_BOLD("L3#%u ") GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), id, Chrono::steadyMSecs() - ts);
+}
+
+
+class RxL3StoragePrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(RxL3StoragePrivate)
+
+    inline RxL3StoragePrivate() :
+        m_domains(l3Domains())
+    {
+        for (uint32_t id = 0; id < m_domains.size(); ++id) {
+            hwloc_obj_t pu = nullptr;
+
+            while ((pu = hwloc_get_next_obj_inside_cpuset_by_type(topology(), m_domains[id]->cpuset, HWLOC_OBJ_PU, pu)) != nullptr) {
+                m_units.insert({ pu->os_index, id });
+            }
+        }
+
+        m_threads.reserve(m_domains.size());
+    }
+
+
+    inline ~RxL3StoragePrivate()
+    {
+        join();
+
+        for (auto const &item : m_datasets) {
+            delete item.second;
+        }
+    }
+
+    inline bool isSized() const
+    {
+        for (const auto &kv : m_datasets) {
+            if (!kv.second->isSized()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    // The cache is owned by one of the datasets.
+    inline void release()
+    {
+        for (auto const &item : m_datasets) {
+            delete item.second;
+        }
+
+        m_datasets.clear();
+
+        m_allocated = false;
+        m_cache     = nullptr;
+    }
+
+
+    inline bool isAllocated() const                 { return m_allocated; }
+    inline bool isReady(const Job &job) const       { return m_ready && m_seed == job; }
+    inline bool isReady(const RxSeed &seed) const   { return m_ready && m_seed == seed; }
+
+
+    inline RxDataset *dataset(int64_t affinity) const
+    {
+        const auto unit = m_units.find(affinity);
+        if (unit != m_units.end() && m_datasets.count(unit->second)) {
+            return m_datasets.at(unit->second);
+        }
+
+        return m_datasets.begin()->second;
+    }
+
+
+    inline void setSeed(const RxSeed &seed)
+    {
+        m_ready = false;
+
+        if (m_seed.algorithm() != seed.algorithm()) {
+            RxAlgo::apply(seed.algorithm());
+        }
+
+        m_seed = seed;
+    }
+
+
+    inline bool createDatasets(bool hugePages, bool oneGbPages)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        for (uint32_t id = 0; id < m_domains.size(); ++id) {
+            m_threads.emplace_back(allocate, this, id, hugePages, oneGbPages);
+        }
+
+        join();
+
+        if (isCacheRequired()) {
+            std::thread thread(allocateCache, this, m_datasets.empty() ? 0 : m_datasets.begin()->first, hugePages);
+            thread.join();
+
+            if (!m_cache) {
+                return false;
+            }
+        }
+
+        if (m_datasets.empty()) {
+            m_datasets.insert({ 0, new RxDataset(m_cache) });
+
+            LOG_WARN(CLEAR "%s" YELLOW_BOLD_S "failed to allocate RandomX datasets, switching to slow mode" BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+        }
+        else {
+            if (m_cache) {
+                m_datasets.begin()->second->setCache(m_cache);
+            }
+
+            printAllocStatus(ts);
+        }
+
+        m_allocated = true;
+
+        return true;
+    }
+
+
+    inline void initDatasets(uint32_t threads, int priority)
+    {
+        uint64_t ts = Chrono::steadyMSecs();
+        uint32_t id = m_datasets.begin()->first;
+
+        for (const auto &kv : m_datasets) {
+            if (kv.second->cache()) {
+                id = kv.first;
+            }
+        }
+
+        auto primary = m_datasets.at(id);
+        primary->init(m_seed.data(), threads, priority);
+
+        printDatasetReady(id, ts);
+
+        if (m_datasets.size() > 1) {
+            for (auto const &item : m_datasets) {
+                if (item.first == id) {
+                    continue;
+                }
+
+                m_threads.emplace_back(copyDataset, item.second, m_domains[item.first], item.first, primary->raw());
+            }
+
+            join();
+        }
+
+        m_ready = true;
+    }
+
+
+    inline HugePagesInfo hugePages() const
+    {
+        HugePagesInfo pages;
+        for (auto const &item : m_datasets) {
+            pages += item.second->hugePages();
+        }
+
+        return pages;
+    }
+
+
+private:
+    static inline hwloc_topology_t topology() { return static_cast<HwlocCpuInfo *>(Cpu::info())->topology(); }
+
+
+    inline bool isCacheRequired() const
+    {
+        if (m_datasets.empty()) {
+            return true;
+        }
+
+        for (const auto &kv : m_datasets) {
+            if (kv.second->isOneGbPages()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    static void allocate(RxL3StoragePrivate *d_ptr, uint32_t id, bool hugePages, bool oneGbPages)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+        hwloc_obj_t cache = d_ptr->m_domains[id];
+
+        if (!bindToL3(cache)) {
+            printSkipped(id, "can't bind memory");
+
+            return;
+        }
+
+        auto dataset = new RxDataset(hugePages, oneGbPages, false, RxConfig::FastMode, nodeOf(cache));
+        if (!dataset->get()) {
+            printSkipped(id, "failed to allocate dataset");
+
+            delete dataset;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        d_ptr->m_datasets.insert({ id, dataset });
+        d_ptr->printAllocStatus(dataset, id, ts);
+    }
+
+
+    static void allocateCache(RxL3StoragePrivate *d_ptr, uint32_t id, bool hugePages)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+        hwloc_obj_t cache = d_ptr->m_domains[id];
+
+        bindToL3(cache);
+
+        auto rxCache = new RxCache(hugePages, nodeOf(cache));
+        if (!rxCache->get()) {
+            delete rxCache;
+
+            LOG_INFO("%s" RED_BOLD("failed to allocate RandomX memory") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        d_ptr->m_cache = rxCache;
+    }
+
+
+    // The copy is made by a thread of the target L3 domain, so the last written lines start in that cache.
+    static void copyDataset(RxDataset *dst, hwloc_obj_t cache, uint32_t id, const void *raw)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        bindToL3(cache);
+        dst->setRaw(raw);
+
+        printDatasetReady(id, ts);
+    }
+
+
+    void printAllocStatus(RxDataset *dataset, uint32_t id, uint64_t ts)
+    {
+        const auto pages = dataset->hugePages();
+
+        LOG_INFO("%s" CYAN_BOLD("L3#%u ") GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") " huge pages %s%3.0f%%" CLEAR BLACK_BOLD(" (%" PRIu64 " ms)"),
+                 Tags::randomx(),
+                 id,
+                 pages.size / oneMiB,
+                 (pages.isFullyAllocated() ? GREEN_BOLD_S : RED_BOLD_S),
+                 pages.percent(),
+                 Chrono::steadyMSecs() - ts
+                 );
+    }
+
+
+    void printAllocStatus(uint64_t ts)
+    {
+        auto pages = hugePages();
+
+        LOG_INFO("%s" CYAN_BOLD("-- ") GREEN_BOLD("allocated") CYAN_BOLD(" %4zu MB") " huge pages %s%3.0f%% %u/%u" CLEAR " L3 domains %zu/%zu" BLACK_BOLD(" (%" PRIu64 " ms)"),
+                 Tags::randomx(),
+                 pages.size / oneMiB,
+                 (pages.isFullyAllocated() ? GREEN_BOLD_S : (pages.allocated == 0 ? RED_BOLD_S : YELLOW_BOLD_S)),
+                 pages.percent(),
+                 pages.allocated,
+                 pages.total,
+                 m_datasets.size(),
+                 m_domains.size(),
+                 Chrono::steadyMSecs() - ts
+                 );
+    }
+
+
+    inline void join()
+    {
+        for (auto &thread : m_threads) {
+            thread.join();
+        }
+
+        m_threads.clear();
+    }
+
+
+    bool m_allocated        = false;
+    bool m_ready            = false;
+    const std::vector<hwloc_obj_t> m_domains;
+    RxCache *m_cache        = nullptr;
+    RxSeed m_seed;
+    std::map<int64_t, uint32_t> m_units;
+    std::map<uint32_t, RxDataset *> m_datasets;
+    std::vector<std::thread> m_threads;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::RxL3Storage::RxL3Storage() :
+    d_ptr(new RxL3StoragePrivate())
+{
+}
+
+
+xmrig::RxL3Storage::~RxL3Storage()
+{
+    delete d_ptr;
+}
+
+
+bool xmrig::RxL3Storage::isSupported()
+{
+    return l3Domains().size() > 1;
+}
+
+
+bool xmrig::RxL3Storage::isAllocated() const
+{
+    return d_ptr->isAllocated();
+}
+
+
+bool xmrig::RxL3Storage::select(const RxSeed &seed)
+{
+    return d_ptr->isReady(seed);
+}
+
+
+xmrig::HugePagesInfo xmrig::RxL3Storage::hugePages() const
+{
+    if (!d_ptr->isAllocated()) {
+        return {};
+    }
+
+    return d_ptr->hugePages();
+}
+
+
+xmrig::RxDataset *xmrig::RxL3Storage::dataset(const Job &job, uint32_t, int64_t affinity) const
+{
+    if (!d_ptr->isReady(job)) {
+        return nullptr;
+    }
+
+    return d_ptr->dataset(affinity);
+}
+
+
+void xmrig::RxL3Storage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode, int priority)
+{
+    d_ptr->setSeed(seed);
+
+    if (d_ptr->isAllocated() && !d_ptr->isSized()) {
+        d_ptr->release();
+    }
+
+    if (!d_ptr->isAllocated() && !d_ptr->createDatasets(hugePages, oneGbPages)) {
+        return;
+    }
+
+    d_ptr->initDatasets(threads, priority);
+}
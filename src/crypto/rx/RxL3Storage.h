@@ -0,0 +1,60 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_L3STORAGE_H
+#define XMRIG_RX_L3STORAGE_H
+
+
+#include "backend/common/interfaces/IRxStorage.h"
+
+
+namespace xmrig
+{
+
+
+class RxL3StoragePrivate;
+
+
+// One dataset copy per L3 cache domain, workers pick the copy by their affinity.
+class RxL3Storage : public IRxStorage
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(RxL3Storage);
+
+    RxL3Storage();
+    ~RxL3Storage() override;
+
+    static bool isSupported();
+
+protected:
+    bool isAllocated() const override;
+    bool select(const RxSeed &seed) override;
+    HugePagesInfo hugePages() const override;
+    RxDataset *dataset(const Job &job, uint32_t nodeId, int64_t affinity) const override;
+    void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
+
+private:
+    RxL3StoragePrivate *d_ptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_L3STORAGE_H */
@@ -0,0 +1,62 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxMemoryPlan.h"
+#include "base/crypto/Algorithm.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+
+
+namespace xmrig {
+
+
+static inline size_t yespowerOffset(const Algorithm &algorithm) { return VirtualMemory::align(algorithm.l3(), 64); }
+
+
+} // namespace xmrig
+
+
+size_t xmrig::RxMemoryPlan::size(const Algorithm &algorithm)
+{
+    if (algorithm != Algorithm::RX_XLA) {
+        return algorithm.l3();
+    }
+
+    return yespowerOffset(algorithm) + randomx_yespower_memory_size();
+}
+
+
+// Must be called by the thread which computes the hashes, yespower memory is thread-local.
+void xmrig::RxMemoryPlan::bind(const Algorithm &algorithm, uint8_t *memory)
+{
+    if (algorithm != Algorithm::RX_XLA || !memory) {
+        unbind();
+
+        return;
+    }
+
+    randomx_set_yespower_memory(memory + yespowerOffset(algorithm), randomx_yespower_memory_size());
+}
+
+
+void xmrig::RxMemoryPlan::unbind()
+{
+    randomx_set_yespower_memory(nullptr, 0);
+}
@@ -0,0 +1,55 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_RX_MEMORYPLAN_H
+#define XMRIG_RX_MEMORYPLAN_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+class Algorithm;
+
+
+// Layout of the per-thread memory of a RandomX worker, one region per hash:
+//
+//     [ scratchpad (L3) | yespower B, V, XY, S (rx/xla only) ]
+//
+// Both Panthera stages share the huge pages of the worker instead of yespower mapping 2 MB of small pages
+// of its own. The parts can't overlap: randomx_calculate_hash_next() runs yespower for the next nonce while
+// the scratchpad still holds the current hash, which hashAndFill() reads only afterwards.
+class RxMemoryPlan
+{
+public:
+    static size_t size(const Algorithm &algorithm);
+    static void bind(const Algorithm &algorithm, uint8_t *memory);
+    static void unbind();
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_MEMORYPLAN_H */
@@ -95,8 +95,35 @@ public:
         }
     }
 
+    inline bool isSized() const
+    {
+        for (const auto &kv : m_datasets) {
+            if (!kv.second->isSized()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    // The cache is owned by one of the datasets.
+    inline void release()
+    {
+        for (auto const &item : m_datasets) {
+            delete item.second;
+        }
+
+        m_datasets.clear();
+
+        m_allocated = false;
+        m_cache     = nullptr;
+    }
+
+
     inline bool isAllocated() const                     { return m_allocated; }
     inline bool isReady(const Job &job) const           { return m_ready && m_seed == job; }
+    inline bool isReady(const RxSeed &seed) const       { return m_ready && m_seed == seed; }
     inline RxDataset *dataset(uint32_t nodeId) const    { return m_datasets.count(nodeId) ? m_datasets.at(nodeId) : m_datasets.at(m_nodeset.front()); }
 
 
@@ -353,6 +380,12 @@ bool xmrig::RxNUMAStorage::isAllocated() const
 }
 
 
+bool xmrig::RxNUMAStorage::select(const RxSeed &seed)
+{
+    return d_ptr->isReady(seed);
+}
+
+
 xmrig::HugePagesInfo xmrig::RxNUMAStorage::hugePages() const
 {
     if (!d_ptr->isAllocated()) {
@@ -363,7 +396,7 @@ xmrig::HugePagesInfo xmrig::RxNUMAStorage::hugePages() const
 }
 
 
-xmrig::RxDataset *xmrig::RxNUMAStorage::dataset(const Job &job, uint32_t nodeId) const
+xmrig::RxDataset *xmrig::RxNUMAStorage::dataset(const Job &job, uint32_t nodeId, int64_t) const
 {
     if (!d_ptr->isReady(job)) {
         return nullptr;
@@ -377,6 +410,10 @@ void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugeP
 {
     d_ptr->setSeed(seed);
 
+    if (d_ptr->isAllocated() && !d_ptr->isSized()) {
+        d_ptr->release();
+    }
+
     if (!d_ptr->isAllocated() && !d_ptr->createDatasets(hugePages, oneGbPages)) {
         return;
     }
@@ -44,8 +44,9 @@ public:
 
 protected:
     bool isAllocated() const override;
+    bool select(const RxSeed &seed) override;
     HugePagesInfo hugePages() const override;
-    RxDataset *dataset(const Job &job, uint32_t nodeId) const override;
+    RxDataset *dataset(const Job &job, uint32_t nodeId, int64_t affinity) const override;
     void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
 
 private:
@@ -0,0 +1,68 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxPhaseGate.h"
+
+
+#ifdef XMRIG_FEATURE_HWLOC
+#   include "backend/cpu/Cpu.h"
+#   include "backend/cpu/platform/HwlocCpuInfo.h"
+
+
+#   include <hwloc.h>
+#   include <map>
+#   include <mutex>
+
+
+namespace xmrig {
+
+
+static std::mutex mutex;
+static std::map<unsigned, RxPhaseGate> gates;
+
+
+} // namespace xmrig
+#endif
+
+
+xmrig::RxPhaseGate *xmrig::RxPhaseGate::get(int64_t affinity)
+{
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (affinity < 0) {
+        return nullptr;
+    }
+
+    auto topology = static_cast<HwlocCpuInfo *>(Cpu::info())->topology();
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(topology, static_cast<unsigned>(affinity));
+    if (!pu) {
+        return nullptr;
+    }
+
+    hwloc_obj_t core = hwloc_get_ancestor_obj_by_type(topology, HWLOC_OBJ_CORE, pu);
+    if (!core || hwloc_bitmap_weight(core->cpuset) < 2) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return &gates[core->logical_index];
+#   else
+    return nullptr;
+#   endif
+}
@@ -0,0 +1,87 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_PHASEGATE_H
+#define XMRIG_RX_PHASEGATE_H
+
+
+#include "base/tools/Object.h"
+#include "crypto/rx/Profiler.h"
+
+
+#include <atomic>
+#include <cstdint>
+
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#   include <immintrin.h>
+#endif
+
+
+namespace xmrig
+{
+
+
+// Shared by the SMT siblings of one physical core. A thread entering the yespower stage of Panthera waits
+// a bounded number of spins while its sibling is in the same stage, so one sibling runs yespower (load ports)
+// while the other runs the RandomX program (AES/FP ports) instead of both fighting for the same units.
+class RxPhaseGate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(RxPhaseGate)
+
+    constexpr static uint32_t kMaxSpins = 4096;
+
+    RxPhaseGate() = default;
+
+    static RxPhaseGate *get(int64_t affinity);
+
+    inline void enter()
+    {
+        if (m_busy.load(std::memory_order_relaxed)) {
+            wait();
+        }
+
+        m_busy.fetch_add(1, std::memory_order_acquire);
+    }
+
+    inline void leave() { m_busy.fetch_sub(1, std::memory_order_release); }
+
+private:
+    inline void wait()
+    {
+        PROFILE_SCOPE(RandomX_phase_wait);
+
+        for (uint32_t i = 0; i < kMaxSpins && m_busy.load(std::memory_order_relaxed); ++i) {
+#           if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#           endif
+        }
+    }
+
+    alignas(64) std::atomic<uint32_t> m_busy{ 0 };
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_PHASEGATE_H */
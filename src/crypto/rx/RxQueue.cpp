@@ -34,7 +34,13 @@
 #include "crypto/rx/RxBasicStorage.h"
 
 
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/rx/RxSharedStorage.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_HWLOC
+#   include "crypto/rx/RxL3Storage.h"
 #   include "crypto/rx/RxNUMAStorage.h"
 #endif
 
@@ -61,12 +67,12 @@ xmrig::RxQueue::~RxQueue()
 }
 
 
-xmrig::RxDataset *xmrig::RxQueue::dataset(const Job &job, uint32_t nodeId)
+xmrig::RxDataset *xmrig::RxQueue::dataset(const Job &job, uint32_t nodeId, int64_t affinity)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
     if (isReadyUnsafe(job)) {
-        return m_storage->dataset(job, nodeId);
+        return m_storage->dataset(job, nodeId, affinity);
     }
 
     return nullptr;
@@ -81,28 +87,57 @@ xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 }
 
 
+std::pair<uint64_t, uint64_t> xmrig::RxQueue::seedCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return { m_hits, m_misses };
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReady(const T &seed)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    return isReadyUnsafe(seed);
+    if (isReadyUnsafe(seed)) {
+        return true;
+    }
+
+    // Switching back to a cached seed of the same algorithm is instant, workers don't need to be stopped.
+    if (m_storage != nullptr && m_state == STATE_IDLE && m_seed.algorithm() == seed.algorithm() && m_storage->select(RxSeed(seed))) {
+        m_seed = RxSeed(seed);
+        ++m_hits;
+
+        return true;
+    }
+
+    return false;
 }
 
 
-void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, bool l3, uint32_t seeds, uint32_t seedsMemory, const String &shared, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
 
     if (!m_storage) {
+#       ifdef XMRIG_OS_LINUX
+        if (!shared.isEmpty() && mode != RxConfig::LightMode) {
+            m_storage = new RxSharedStorage(shared);
+        }
+        else
+#       endif
 #       ifdef XMRIG_FEATURE_HWLOC
-        if (!nodeset.empty()) {
+        if (l3 && mode != RxConfig::LightMode && RxL3Storage::isSupported()) {
+            m_storage = new RxL3Storage();
+        }
+        else if (!nodeset.empty()) {
             m_storage = new RxNUMAStorage(nodeset);
         }
         else
 #       endif
         {
-            m_storage = new RxBasicStorage();
+            m_storage = new RxBasicStorage(seeds, seedsMemory);
         }
     }
 
@@ -143,19 +178,32 @@ void xmrig::RxQueue::backgroundInit()
         const auto item = m_queue.back();
         m_queue.clear();
 
-        lock.unlock();
+        if (m_storage->select(item.seed)) {
+            ++m_hits;
+
+            LOG_INFO("%s" GREEN_BOLD("dataset ready") " algo " WHITE_BOLD("%s") BLACK_BOLD(" seed %s... (cached)"),
+                     Tags::randomx(),
+                     item.seed.algorithm().shortName(),
+                     Cvt::toHex(item.seed.data().data(), 8).data()
+                     );
+        }
+        else {
+            ++m_misses;
 
-        LOG_INFO("%s" MAGENTA_BOLD("init dataset%s") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
-                 Tags::randomx(),
-                 item.nodeset.size() > 1 ? "s" : "",
-                 item.seed.algorithm().shortName(),
-                 item.threads,
-                 Cvt::toHex(item.seed.data().data(), 8).data()
-                 );
+            lock.unlock();
 
-        m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
+            LOG_INFO("%s" MAGENTA_BOLD("init dataset%s") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
+                     Tags::randomx(),
+                     item.nodeset.size() > 1 ? "s" : "",
+                     item.seed.algorithm().shortName(),
+                     item.threads,
+                     Cvt::toHex(item.seed.data().data(), 8).data()
+                     );
 
-        lock.lock();
+            m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
+
+            lock.lock();
+        }
 
         if (m_state == STATE_SHUTDOWN || !m_queue.empty()) {
             continue;
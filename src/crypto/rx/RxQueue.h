@@ -47,6 +47,7 @@ namespace xmrig
 class IRxListener;
 class IRxStorage;
 class RxDataset;
+class String;
 
 
 class RxQueueItem
@@ -81,9 +82,10 @@ public:
     ~RxQueue() override;
 
     HugePagesInfo hugePages();
-    RxDataset *dataset(const Job &job, uint32_t nodeId);
+    RxDataset *dataset(const Job &job, uint32_t nodeId, int64_t affinity);
+    std::pair<uint64_t, uint64_t> seedCache();
     template<typename T> bool isReady(const T &seed);
-    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
+    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, bool l3, uint32_t seeds, uint32_t seedsMemory, const String &shared, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
 
 protected:
     inline void onAsync() override  { onReady(); }
@@ -108,6 +110,8 @@ private:
     std::shared_ptr<Async> m_async;
     std::thread m_thread;
     std::vector<RxQueueItem> m_queue;
+    uint64_t m_hits     = 0;
+    uint64_t m_misses   = 0;
 };
 
 
@@ -0,0 +1,392 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxSharedStorage.h"
+#include "backend/common/Tags.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Cgroup.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "base/tools/String.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <thread>
+#include <unistd.h>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kSharedMagic     = 0x3144534152474c58ULL; // "XLGRASD1"
+constexpr size_t kSharedHeaderSize  = 4096;
+constexpr long kHugetlbfsMagic      = 0x958458f6;
+
+
+// Placed right after the dataset, the builder writes it last, so a file with a valid header always holds a complete dataset.
+struct RxSharedHeader
+{
+    std::atomic<uint64_t> magic;
+    uint64_t size;
+};
+
+
+class RxSharedStoragePrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxSharedStoragePrivate)
+
+    inline RxSharedStoragePrivate(const String &path) : m_path(path) {}
+    inline ~RxSharedStoragePrivate()                { release(); }
+
+    inline bool isReady(const Job &job) const       { return m_ready && m_seed == job; }
+    inline bool isReady(const RxSeed &seed) const   { return m_ready && m_seed == seed; }
+    inline RxDataset *dataset() const               { return m_dataset; }
+
+
+    inline HugePagesInfo hugePages() const
+    {
+        if (!m_memory) {
+            return m_dataset ? m_dataset->hugePages() : HugePagesInfo();
+        }
+
+        HugePagesInfo pages;
+        pages.size      = m_size;
+        pages.total     = m_size / (m_hugetlbfs ? m_pageSize : VirtualMemory::kDefaultHugePageSize);
+        pages.allocated = m_hugetlbfs ? pages.total : 0;
+
+        return pages;
+    }
+
+
+    void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+    {
+        release();
+
+        if (m_seed.algorithm() != seed.algorithm()) {
+            RxAlgo::apply(seed.algorithm());
+        }
+
+        m_seed = seed;
+
+        if (mode == RxConfig::AutoMode && Cgroup::totalMemory() < (RxDataset::requiredSize() + RxCache::requiredSize())) {
+            initPrivate(threads, hugePages, oneGbPages, mode, priority);
+
+            return;
+        }
+
+        if (!initShared(threads, hugePages, priority)) {
+            release();
+
+            LOG_WARN("%s" YELLOW_BOLD("shared dataset is not available, using a private one"), Tags::randomx());
+
+            initPrivate(threads, hugePages, oneGbPages, mode, priority);
+        }
+    }
+
+
+private:
+    bool error(const char *call)
+    {
+        LOG_ERR("%s" RED_BOLD("shared dataset ") WHITE_BOLD("\"%s\"") RED(" %s failed: \"%s\""), Tags::randomx(), m_file.data(), call, strerror(errno));
+
+        return false;
+    }
+
+
+    bool initShared(uint32_t threads, bool hugePages, int priority)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        const String hex = Cvt::toHex(m_seed.data());
+        const size_t size = m_path.size() + strlen(m_seed.algorithm().shortName()) + hex.size() + 10;
+        char *file        = new char[size]();
+        snprintf(file, size, "%s/xlarig-%s-%s", m_path.data(), m_seed.algorithm().shortName(), hex.data());
+
+        for (char *p = file + m_path.size() + 1; *p; ++p) {
+            if (*p == '/') {
+                *p = '-';
+            }
+        }
+
+        m_file = file;
+
+        m_fd = open(m_file, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (m_fd < 0) {
+            return error("open");
+        }
+
+        struct statfs fs{};
+        if (fstatfs(m_fd, &fs) != 0) {
+            return error("fstatfs");
+        }
+
+        m_hugetlbfs   = static_cast<long>(fs.f_type) == kHugetlbfsMagic;
+        m_pageSize    = fs.f_bsize > 0 ? static_cast<size_t>(fs.f_bsize) : 4096;
+        m_datasetSize = RxDataset::requiredSize();
+        m_size        = VirtualMemory::align(m_datasetSize + kSharedHeaderSize, m_pageSize);
+
+        // The builder holds an exclusive lock until the dataset is complete, users of a complete file hold a shared one.
+        while (true) {
+            if (!lock(LOCK_SH)) {
+                return false;
+            }
+
+            if (attach(ts)) {
+                break;
+            }
+
+            flock(m_fd, LOCK_UN);
+
+            if (flock(m_fd, LOCK_EX | LOCK_NB) == 0) {
+                if (!attach(ts) && !build(threads, hugePages, priority, ts)) {
+                    return false;
+                }
+
+                flock(m_fd, LOCK_SH);
+                break;
+            }
+
+            if (errno != EWOULDBLOCK && errno != EINTR) {
+                return error("flock");
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        m_ready = true;
+
+        return true;
+    }
+
+
+    bool lock(int operation)
+    {
+        while (flock(m_fd, operation) != 0) {
+            if (errno != EINTR) {
+                return error("flock");
+            }
+        }
+
+        return true;
+    }
+
+
+    // Maps the file read-only if it holds a complete dataset.
+    bool attach(uint64_t ts)
+    {
+        struct stat st{};
+        if (fstat(m_fd, &st) != 0 || static_cast<size_t>(st.st_size) != m_size || !map(PROT_READ)) {
+            return false;
+        }
+
+        if (header()->magic.load(std::memory_order_acquire) != kSharedMagic || header()->size != m_datasetSize) {
+            munmap(m_memory, m_size);
+            m_memory = nullptr;
+
+            return false;
+        }
+
+        m_dataset = new RxDataset(m_memory, nullptr);
+
+        LOG_INFO("%s" GREEN_BOLD("use shared dataset ") WHITE_BOLD("\"%s\"") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), m_file.data(), Chrono::steadyMSecs() - ts);
+
+        return true;
+    }
+
+
+    bool build(uint32_t threads, bool hugePages, int priority, uint64_t ts)
+    {
+        if (ftruncate(m_fd, 0) != 0 || ftruncate(m_fd, static_cast<off_t>(m_size)) != 0) {
+            return error("ftruncate");
+        }
+
+        if (!map(PROT_READ | PROT_WRITE)) {
+            ftruncate(m_fd, 0);
+
+            return false;
+        }
+
+        auto cache = new RxCache(hugePages, 0);
+        if (!cache->get()) {
+            delete cache;
+            ftruncate(m_fd, 0);
+
+            return false;
+        }
+
+        m_dataset = new RxDataset(m_memory, cache);
+        m_dataset->init(m_seed.data(), threads, priority);
+
+        // Fast mode doesn't need the cache, processes that map the dataset don't have it either.
+        m_dataset->setCache(nullptr);
+        delete cache;
+
+        header()->size = m_datasetSize;
+        header()->magic.store(kSharedMagic, std::memory_order_release);
+
+        mprotect(m_memory, m_size, PROT_READ);
+
+        LOG_INFO("%s" GREEN_BOLD("shared dataset ready ") WHITE_BOLD("\"%s\"") " huge pages %s" BLACK_BOLD(" (%" PRIu64 " ms)"),
+                 Tags::randomx(),
+                 m_file.data(),
+                 m_hugetlbfs ? GREEN_BOLD_S "hugetlbfs" CLEAR : RED_BOLD_S "no" CLEAR,
+                 Chrono::steadyMSecs() - ts
+                 );
+
+        return true;
+    }
+
+
+    bool map(int prot)
+    {
+        void *memory = mmap(nullptr, m_size, prot, MAP_SHARED | MAP_POPULATE, m_fd, 0);
+        if (memory == MAP_FAILED) {
+            return error("mmap");
+        }
+
+        m_memory = static_cast<uint8_t *>(memory);
+
+        return true;
+    }
+
+
+    inline RxSharedHeader *header() const { return reinterpret_cast<RxSharedHeader *>(m_memory + m_datasetSize); }
+
+
+    void initPrivate(uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+    {
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        if (!m_dataset->cache()->get()) {
+            delete m_dataset;
+            m_dataset = nullptr;
+
+            return;
+        }
+
+        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+
+        if (m_ready) {
+            LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+        }
+    }
+
+
+    // The last process which uses the file removes it, a process that still maps it keeps the data alive.
+    void release()
+    {
+        m_ready = false;
+
+        delete m_dataset;
+        m_dataset = nullptr;
+
+        if (m_memory) {
+            munmap(m_memory, m_size);
+            m_memory = nullptr;
+        }
+
+        if (m_fd >= 0) {
+            if (flock(m_fd, LOCK_EX | LOCK_NB) == 0) {
+                unlink(m_file);
+            }
+
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+
+    bool m_hugetlbfs        = false;
+    bool m_ready            = false;
+    const String m_path;
+    int m_fd                = -1;
+    RxDataset *m_dataset    = nullptr;
+    RxSeed m_seed;
+    size_t m_datasetSize    = 0;
+    size_t m_pageSize       = 0;
+    size_t m_size           = 0;
+    String m_file;
+    uint8_t *m_memory       = nullptr;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::RxSharedStorage::RxSharedStorage(const String &path) :
+    d_ptr(new RxSharedStoragePrivate(path))
+{
+}
+
+
+xmrig::RxSharedStorage::~RxSharedStorage()
+{
+    delete d_ptr;
+}
+
+
+bool xmrig::RxSharedStorage::isAllocated() const
+{
+    return d_ptr->dataset() != nullptr;
+}
+
+
+bool xmrig::RxSharedStorage::select(const RxSeed &seed)
+{
+    return d_ptr->isReady(seed);
+}
+
+
+xmrig::HugePagesInfo xmrig::RxSharedStorage::hugePages() const
+{
+    return d_ptr->hugePages();
+}
+
+
+xmrig::RxDataset *xmrig::RxSharedStorage::dataset(const Job &job, uint32_t, int64_t) const
+{
+    if (!d_ptr->isReady(job)) {
+        return nullptr;
+    }
+
+    return d_ptr->dataset();
+}
+
+
+void xmrig::RxSharedStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+{
+    d_ptr->init(seed, threads, hugePages, oneGbPages, mode, priority);
+}
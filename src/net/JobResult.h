@@ -32,6 +32,7 @@
 #include <cstdint>
 
 
+#include "base/tools/Chrono.h"
 #include "base/tools/String.h"
 #include "base/net/stratum/Job.h"
 
@@ -51,7 +52,8 @@ public:
         backend(job.backend()),
         nonce(nonce),
         diff(job.diff()),
-        index(job.index())
+        index(job.index()),
+        timestamp(Chrono::steadyMSecs())
     {
         memcpy(m_result, result, sizeof(m_result));
 
@@ -71,7 +73,8 @@ public:
         backend(job.backend()),
         nonce(0),
         diff(0),
-        index(job.index())
+        index(job.index()),
+        timestamp(Chrono::steadyMSecs())
     {
     }
 
@@ -88,6 +91,7 @@ public:
     const uint64_t nonce;
     const uint64_t diff;
     const uint8_t index;
+    const uint64_t timestamp;
 
 private:
     uint8_t m_result[32]     = { 0 };
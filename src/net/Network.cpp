@@ -35,6 +35,7 @@
 #include "base/net/stratum/Client.h"
 #include "base/net/stratum/NetworkState.h"
 #include "base/net/stratum/SubmitResult.h"
+#include "base/net/stratum/strategies/WeightedStrategy.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
@@ -77,6 +78,7 @@ xmrig::Network::Network(Controller *controller) :
 
     const Pools &pools = controller->config()->pools();
     m_strategy = pools.createStrategy(m_state);
+    m_split    = pools.weights().size() > 1;
 
     if (pools.donateLevel() > 0) {
         m_donate = new DonateStrategy(controller, this);
@@ -160,6 +162,7 @@ void xmrig::Network::onConfigChanged(Config *config, Config *previousConfig)
 
     delete m_strategy;
     m_strategy = config->pools().createStrategy(m_state);
+    m_split    = config->pools().weights().size() > 1;
     connect();
 }
 
@@ -170,7 +173,8 @@ void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job,
         return;
     }
 
-    setJob(client, job, m_donate == strategy);
+    const bool donate = m_donate == strategy;
+    setJob(client, job, donate, (!donate && m_split) ? client->id() : -1);
 }
 
 
@@ -181,6 +185,10 @@ void xmrig::Network::onJobResult(const JobResult &result)
         return;
     }
 
+    if (result.diff == 0 && m_controller->miner()->resumeBacklog(result)) {
+        return;
+    }
+
     m_strategy->submit(result);
 }
 
@@ -206,6 +214,10 @@ void xmrig::Network::onLogin(IStrategy *, IClient *client, rapidjson::Document &
     }
 
     params.AddMember("algo", algo, allocator);
+
+    if (client->pool().minDiff()) {
+        params.AddMember("diff", client->pool().minDiff(), allocator);
+    }
 }
 
 
@@ -221,6 +233,17 @@ void xmrig::Network::onPause(IStrategy *strategy)
 
         return m_controller->miner()->pause();
     }
+
+    // Threads of a disconnected weighted pool stay idle until it sends a new job.
+    if (m_split && m_strategy == strategy) {
+        const auto weighted = static_cast<const WeightedStrategy *>(m_strategy);
+
+        for (size_t i = 0; i < weighted->count(); ++i) {
+            if (!weighted->isActive(i)) {
+                m_controller->miner()->setJob(Job(), static_cast<uint32_t>(i));
+            }
+        }
+    }
 }
 
 
@@ -263,7 +286,7 @@ void xmrig::Network::onRequest(IApiRequest &request)
 #endif
 
 
-void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
+void xmrig::Network::setJob(IClient *client, const Job &job, bool donate, int partition)
 {
 #   ifdef XMRIG_FEATURE_BENCHMARK
     if (!BenchState::size())
@@ -290,7 +313,20 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
         }
     }
 
-    m_controller->miner()->setJob(job, donate);
+    // Shares below the pool's min-diff are dropped by the workers, results are accounted at the raised difficulty.
+    const uint64_t minDiff = donate ? 0 : client->pool().minDiff();
+    Job next(job);
+
+    if (minDiff > job.diff()) {
+        next.setDiff(minDiff);
+    }
+
+    // Jobs of weighted pools go to the CPU threads of their partition.
+    if (partition >= 0) {
+        return m_controller->miner()->setJob(next, static_cast<uint32_t>(partition));
+    }
+
+    m_controller->miner()->setJob(next, donate);
 }
 
 
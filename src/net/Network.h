@@ -79,7 +79,7 @@ protected:
 private:
     constexpr static int kTickInterval = 1 * 1000;
 
-    void setJob(IClient *client, const Job &job, bool donate);
+    void setJob(IClient *client, const Job &job, bool donate, int partition);
     void tick();
 
 #   ifdef XMRIG_FEATURE_API
@@ -87,6 +87,7 @@ private:
     void getResults(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
 #   endif
 
+    bool m_split            = false;
     Controller *m_controller;
     IStrategy *m_donate     = nullptr;
     IStrategy *m_strategy   = nullptr;
@@ -0,0 +1,357 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "verify/Verifier.h"
+#include "backend/cpu/Cpu.h"
+#include "base/kernel/Platform.h"
+#include "base/net/stratum/Job.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxVm.h"
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class VerifierWorker
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(VerifierWorker)
+
+    inline VerifierWorker(int64_t affinity) : affinity(affinity) {}
+
+    inline ~VerifierWorker()
+    {
+        RxVm::destroy(vm);
+        delete memory;
+    }
+
+    const int64_t affinity;
+    randomx_vm *vm          = nullptr;
+    std::thread thread;
+    uint64_t generation     = 0;
+    VirtualMemory *memory   = nullptr;
+};
+
+
+class VerifierPrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(VerifierPrivate)
+
+    // The verifier has its own copy of the variant parameters, the process wide RandomX configuration is never touched.
+    VerifierPrivate(const Algorithm &algorithm, const Buffer &seed, const xlarig_verify_options &options) :
+        algorithm(algorithm),
+        seed(seed),
+        options(options),
+        config(*RxAlgo::base(algorithm))
+    {
+        config.Apply();
+    }
+
+
+    // A dataset build in progress can't be interrupted, destroying the verifier waits for it.
+    inline ~VerifierPrivate()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        shutdown = true;
+        lock.unlock();
+
+        cv.notify_all();
+
+        if (builder.joinable()) {
+            builder.join();
+        }
+
+        for (auto worker : workers) {
+            worker->thread.join();
+            delete worker;
+        }
+
+        delete next;
+        delete dataset;
+    }
+
+
+    inline bool isFull() const { return full; }
+
+
+    bool init()
+    {
+        RandomX_ConfigScope scope(&config);
+
+        const bool hugePages = options.huge_pages != 0;
+        const uint32_t threads = this->threads();
+
+        if (options.mode == XLARIG_VERIFY_MODE_FULL) {
+            dataset = new RxDataset(hugePages, false, true, RxConfig::FastMode, 0);
+        }
+        else {
+            dataset = new RxDataset(new RxCache(hugePages, 0));
+        }
+
+        if (!dataset->cache() || !dataset->cache()->get() || !dataset->init(seed, threads, 0)) {
+            return false;
+        }
+
+        full       = dataset->get() != nullptr;
+        generation = 1;
+
+        const auto &units = Cpu::info()->units();
+        workers.reserve(threads);
+
+        for (uint32_t i = 0; i < threads; ++i) {
+            auto worker = new VerifierWorker((options.affinity && !units.empty()) ? units[i % units.size()] : -1);
+            worker->thread = std::thread(&VerifierPrivate::onThread, this, worker);
+
+            workers.push_back(worker);
+        }
+
+        return true;
+    }
+
+
+    int hash(const xlarig_verify_item *items, size_t count, uint8_t *hashes)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            if (!items[i].blob || items[i].size < XLARIG_VERIFY_NONCE_OFFSET + sizeof(uint32_t) || items[i].size > Job::kMaxBlobSize) {
+                return XLARIG_VERIFY_ERR_BLOB_SIZE;
+            }
+        }
+
+        std::lock_guard<std::mutex> batchLock(batchMutex);
+
+        if (options.mode == XLARIG_VERIFY_MODE_AUTO && !builder.joinable() && count >= options.full_threshold) {
+            builder = std::thread(&VerifierPrivate::onBuild, this);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Workers are idle between batches, so the old dataset and their VMs can be replaced here.
+        if (next) {
+            next->setCache(dataset->cache());
+            dataset->setCache(nullptr);
+
+            delete dataset;
+            dataset = next;
+            next    = nullptr;
+            full    = true;
+            ++generation;
+        }
+
+        m_items   = items;
+        m_count   = count;
+        m_hashes  = hashes;
+        m_next    = 0;
+        m_pending = workers.size();
+        ++m_batch;
+        lock.unlock();
+
+        cv.notify_all();
+
+        lock.lock();
+        done.wait(lock, [this]{ return m_pending == 0; });
+
+        return m_next.load(std::memory_order_relaxed) < m_count ? XLARIG_VERIFY_ERR_MEMORY : XLARIG_VERIFY_OK;
+    }
+
+
+    std::vector<VerifierWorker *> workers;
+    RxDataset *dataset  = nullptr;
+
+private:
+    inline uint32_t threads() const { return options.threads ? options.threads : static_cast<uint32_t>(Cpu::info()->threads()); }
+
+
+    // Builds the full dataset from the cache while batches are still hashed in light mode, hash() swaps it in once it's ready.
+    void onBuild()
+    {
+        RandomX_ConfigScope scope(&config);
+
+        auto result = new RxDataset(options.huge_pages != 0, false, false, RxConfig::FastMode, 0);
+        if (!result->get()) {
+            delete result;
+
+            return;
+        }
+
+        // The light dataset owns the cache, it is only read here: its seed is already initialized.
+        result->setCache(dataset->cache());
+        const bool ok = result->init(seed, threads(), 0);
+        result->setCache(nullptr);
+
+        if (!ok) {
+            delete result;
+
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        next = result;
+    }
+
+
+    // Scratchpad and VM are created on the first batch which needs them, and retried on the next batch if that failed.
+    randomx_vm *createVm(VerifierWorker *worker, uint32_t node) const
+    {
+        if (worker->memory && !worker->memory->scratchpad()) {
+            delete worker->memory;
+            worker->memory = nullptr;
+        }
+
+        if (!worker->memory) {
+            worker->memory = new (std::nothrow) VirtualMemory(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, options.huge_pages != 0, false, false, node);
+        }
+
+        if (!worker->memory || !worker->memory->scratchpad()) {
+            return nullptr;
+        }
+
+        return RxVm::create(dataset, worker->memory->scratchpad(), !Cpu::info()->hasAES(), Assembly::AUTO, node);
+    }
+
+
+    void onThread(VerifierWorker *worker)
+    {
+        RandomX_ConfigScope scope(&config);
+
+        const uint32_t node = VirtualMemory::bindToNUMANode(worker->affinity);
+        Platform::trySetThreadAffinity(worker->affinity);
+
+        uint64_t batch = 0;
+        alignas(16) uint8_t blob[Job::kMaxBlobSize];
+
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this, batch]{ return shutdown || m_batch != batch; });
+
+            if (shutdown) {
+                return;
+            }
+
+            batch = m_batch;
+
+            if (worker->generation != generation || !worker->vm) {
+                RxVm::destroy(worker->vm);
+                worker->vm         = createVm(worker, node);
+                worker->generation = generation;
+            }
+
+            lock.unlock();
+
+            // A worker without a VM leaves the batch to the others, if none of them has one the items stay unclaimed.
+            size_t i;
+            while (worker->vm && (i = m_next.fetch_add(1, std::memory_order_relaxed)) < m_count) {
+                const auto &item = m_items[i];
+
+                memcpy(blob, item.blob, item.size);
+                memcpy(blob + XLARIG_VERIFY_NONCE_OFFSET, &item.nonce, sizeof(item.nonce));
+
+                randomx_calculate_hash(worker->vm, blob, item.size, m_hashes + i * XLARIG_VERIFY_HASH_SIZE, algorithm);
+            }
+
+            lock.lock();
+            if (--m_pending == 0) {
+                lock.unlock();
+                done.notify_one();
+            }
+        }
+    }
+
+
+    bool shutdown                       = false;
+    std::atomic<bool> full              { false };
+    const Algorithm algorithm;
+    const Buffer seed;
+    const xlarig_verify_item *m_items   = nullptr;
+    const xlarig_verify_options options;
+    RandomX_ConfigurationBase config;
+    RxDataset *next                     = nullptr;
+    std::atomic<size_t> m_next          { 0 };
+    std::condition_variable cv;
+    std::condition_variable done;
+    std::mutex batchMutex;
+    std::mutex mutex;
+    std::thread builder;
+    size_t m_count                      = 0;
+    size_t m_pending                    = 0;
+    uint64_t generation                 = 0;
+    uint64_t m_batch                    = 0;
+    uint8_t *m_hashes                   = nullptr;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::Verifier::Verifier(const Algorithm &algorithm, const Buffer &seed, const xlarig_verify_options &options)
+{
+    if (algorithm.family() != Algorithm::RANDOM_X || seed.empty()) {
+        d_ptr = nullptr;
+
+        return;
+    }
+
+    d_ptr = new VerifierPrivate(algorithm, seed, options);
+
+    if (!d_ptr->init()) {
+        delete d_ptr;
+        d_ptr = nullptr;
+    }
+}
+
+
+xmrig::Verifier::~Verifier()
+{
+    delete d_ptr;
+}
+
+
+bool xmrig::Verifier::isFull() const
+{
+    return d_ptr && d_ptr->isFull();
+}
+
+
+bool xmrig::Verifier::isValid() const
+{
+    return d_ptr != nullptr;
+}
+
+
+int xmrig::Verifier::hash(const xlarig_verify_item *items, size_t count, uint8_t *hashes)
+{
+    if (!d_ptr || (count && (!items || !hashes))) {
+        return XLARIG_VERIFY_ERR_ARGS;
+    }
+
+    return count ? d_ptr->hash(items, count, hashes) : XLARIG_VERIFY_OK;
+}
@@ -0,0 +1,57 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_VERIFIER_H
+#define XMRIG_VERIFIER_H
+
+
+#include "base/crypto/Algorithm.h"
+#include "base/tools/Buffer.h"
+#include "base/tools/Object.h"
+#include "verify/xlarig-verify.h"
+
+
+namespace xmrig
+{
+
+
+class VerifierPrivate;
+
+
+class Verifier
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Verifier)
+
+    Verifier(const Algorithm &algorithm, const Buffer &seed, const xlarig_verify_options &options);
+    ~Verifier();
+
+    bool isFull() const;
+    bool isValid() const;
+    int hash(const xlarig_verify_item *items, size_t count, uint8_t *hashes);
+
+private:
+    VerifierPrivate *d_ptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_VERIFIER_H */
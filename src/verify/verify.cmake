@@ -0,0 +1,23 @@
+if (WITH_VERIFY_LIB)
+    set(HEADERS_VERIFY
+        src/verify/Verifier.h
+        src/verify/xlarig-verify.h
+        )
+
+    set(SOURCES_VERIFY
+        src/verify/Verifier.cpp
+        src/verify/xlarig-verify.cpp
+        )
+
+    add_library(xlarig-verify STATIC ${HEADERS_VERIFY} ${SOURCES_VERIFY} $<TARGET_OBJECTS:xlarig-rx-core>)
+    target_link_libraries(xlarig-verify ${RX_CORE_LIBRARIES})
+
+    add_executable(xlarig-verify-bench src/verify/xlarig-verify-bench.cpp)
+    target_link_libraries(xlarig-verify-bench xlarig-verify)
+
+    add_executable(xlarig-verify-test src/verify/xlarig-verify-test.cpp)
+    target_link_libraries(xlarig-verify-test xlarig-verify)
+
+    enable_testing()
+    add_test(NAME xlarig-verify COMMAND xlarig-verify-test)
+endif()
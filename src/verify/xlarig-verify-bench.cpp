@@ -0,0 +1,128 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput benchmark for the verify library, it uses only the public C API.
+ *
+ * usage: xlarig-verify-bench [algo] [batch size] [batches] [threads] [mode: auto|light|full]
+ */
+
+#include "verify/xlarig-verify.h"
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+static int parseMode(const char *mode)
+{
+    if (strcmp(mode, "light") == 0) {
+        return XLARIG_VERIFY_MODE_LIGHT;
+    }
+
+    if (strcmp(mode, "full") == 0) {
+        return XLARIG_VERIFY_MODE_FULL;
+    }
+
+    return XLARIG_VERIFY_MODE_AUTO;
+}
+
+
+static double elapsed(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *algo     = argc > 1 ? argv[1] : "panthera";
+    const size_t batch   = argc > 2 ? strtoul(argv[2], nullptr, 10) : 256;
+    const size_t batches = argc > 3 ? strtoul(argv[3], nullptr, 10) : 4;
+
+    xlarig_verify_options options;
+    xlarig_verify_options_init(&options);
+
+    options.threads = argc > 4 ? static_cast<unsigned>(strtoul(argv[4], nullptr, 10)) : 0;
+    options.mode    = argc > 5 ? parseMode(argv[5]) : XLARIG_VERIFY_MODE_AUTO;
+
+    if (!batch || !batches) {
+        fprintf(stderr, "invalid batch size\n");
+
+        return 1;
+    }
+
+    const char seed[] = "xlarig-verify-bench";
+
+    auto start    = std::chrono::steady_clock::now();
+    auto verifier = xlarig_verifier_create(algo, seed, sizeof(seed) - 1, &options);
+    if (!verifier) {
+        fprintf(stderr, "failed to create verifier for \"%s\"\n", algo);
+
+        return 1;
+    }
+
+    printf("%-16s%.3f s\n", "create", elapsed(start));
+
+    uint8_t blob[76] = { 0 };
+    std::vector<xlarig_verify_item> items(batch);
+    std::vector<uint8_t> hashes(batch * XLARIG_VERIFY_HASH_SIZE);
+
+    uint32_t nonce = 0;
+    double total   = 0.0;
+
+    for (size_t b = 0; b < batches; ++b) {
+        for (auto &item : items) {
+            item.blob  = blob;
+            item.size  = sizeof(blob);
+            item.nonce = nonce++;
+        }
+
+        start = std::chrono::steady_clock::now();
+
+        const int rc = xlarig_verifier_hash(verifier, items.data(), items.size(), hashes.data());
+        if (rc != XLARIG_VERIFY_OK) {
+            fprintf(stderr, "hash failed: %d\n", rc);
+            xlarig_verifier_destroy(verifier);
+
+            return 1;
+        }
+
+        const double t = elapsed(start);
+        total += t;
+
+        printf("batch %-10zu%.3f s %10.1f H/s %s\n", b, t, batch / t, xlarig_verifier_is_full(verifier) ? "full" : "light");
+    }
+
+    printf("%-16s%10.1f H/s\n", "total", (batch * batches) / total);
+    printf("%-16s", "first hash");
+
+    for (size_t i = 0; i < XLARIG_VERIFY_HASH_SIZE; ++i) {
+        printf("%02x", hashes[i]);
+    }
+
+    printf("\n");
+
+    xlarig_verifier_destroy(verifier);
+
+    return 0;
+}
@@ -0,0 +1,293 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Tests of the verify library C API: known answers for rx/0 and rx/xla, agreement with the hash computed the way
+ * the miner does it, verifiers of two variants side by side, the AUTO mode switch and the error codes.
+ *
+ * usage: xlarig-verify-test
+ */
+
+#include "verify/xlarig-verify.h"
+#include "backend/cpu/Cpu.h"
+#include "base/crypto/Algorithm.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxVm.h"
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+#ifdef __linux__
+#   include <sys/resource.h>
+#endif
+
+
+namespace xmrig {
+
+
+static int failures = 0;
+
+
+#define CHECK(x) do { if (!(x)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); ++failures; } } while (0)
+
+
+static const char kKey[]    = "test key 000";
+static const char kInput[]  = "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua";
+
+// RandomX reference test vector for this key and input.
+static const char kHashRx0[] = "c36d4ed4191e617309867ed66a443be4075014e2b061bcdaf9ce7b721d2b77a8";
+
+// Computed by the miner (light VM with the global configuration applied) for the same key and input.
+static const char kHashXla[] = "3ff0f3adb20bc3a90a3cae22064c533e048d4849193af272705156d7e392e293";
+
+
+static std::string toHex(const uint8_t *data, size_t size)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::string out;
+
+    for (size_t i = 0; i < size; ++i) {
+        out += hex[data[i] >> 4];
+        out += hex[data[i] & 0x0f];
+    }
+
+    return out;
+}
+
+
+// The input already holds the nonce bytes, writing them back keeps the reference input unchanged.
+static xlarig_verify_item item()
+{
+    xlarig_verify_item out;
+    out.blob = kInput;
+    out.size = sizeof(kInput) - 1;
+    memcpy(&out.nonce, kInput + XLARIG_VERIFY_NONCE_OFFSET, sizeof(out.nonce));
+
+    return out;
+}
+
+
+static xlarig_verifier *create(const char *algo, int mode, unsigned threads = 2, size_t fullThreshold = 256)
+{
+    xlarig_verify_options options;
+    xlarig_verify_options_init(&options);
+
+    options.threads         = threads;
+    options.mode            = mode;
+    options.full_threshold  = fullThreshold;
+    options.huge_pages      = 0;
+    options.affinity        = 0;
+
+    return xlarig_verifier_create(algo, kKey, sizeof(kKey) - 1, &options);
+}
+
+
+static std::string hash(xlarig_verifier *verifier, size_t count = 1)
+{
+    std::vector<xlarig_verify_item> items(count, item());
+    std::vector<uint8_t> hashes(count * XLARIG_VERIFY_HASH_SIZE);
+
+    if (xlarig_verifier_hash(verifier, items.data(), count, hashes.data()) != XLARIG_VERIFY_OK) {
+        return {};
+    }
+
+    for (size_t i = 1; i < count; ++i) {
+        if (memcmp(hashes.data(), hashes.data() + i * XLARIG_VERIFY_HASH_SIZE, XLARIG_VERIFY_HASH_SIZE) != 0) {
+            return "mismatch within batch";
+        }
+    }
+
+    return toHex(hashes.data(), XLARIG_VERIFY_HASH_SIZE);
+}
+
+
+// The miner's path: configuration applied process wide, RxCache and a light VM, as CpuWorker uses them.
+static std::string minerHash(const Algorithm &algorithm)
+{
+    RxAlgo::apply(algorithm);
+
+    RxDataset dataset(new RxCache(false, 0));
+    dataset.init(Buffer(kKey, kKey + sizeof(kKey) - 1), 1, 0);
+
+    VirtualMemory scratchpad(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, false, false, false);
+    randomx_vm *vm = RxVm::create(&dataset, scratchpad.scratchpad(), !Cpu::info()->hasAES(), Assembly::AUTO, 0);
+    if (!vm) {
+        return {};
+    }
+
+    uint8_t out[RANDOMX_HASH_SIZE];
+    randomx_calculate_hash(vm, kInput, sizeof(kInput) - 1, out, algorithm);
+    RxVm::destroy(vm);
+
+    return toHex(out, sizeof(out));
+}
+
+
+static void testKnownAnswers()
+{
+    CHECK(minerHash(Algorithm::RX_XLA) == kHashXla);
+    CHECK(minerHash(Algorithm::RX_0) == kHashRx0);
+
+    // Verifiers don't change the configuration of the process: rx/0 stays applied while a panthera verifier lives.
+    const uint32_t argonMemory = RandomX_CurrentConfig.ArgonMemory;
+
+    auto xla = create("panthera", XLARIG_VERIFY_MODE_LIGHT);
+    auto rx0 = create("rx/0", XLARIG_VERIFY_MODE_LIGHT);
+    CHECK(xla && rx0);
+    CHECK(RandomX_CurrentConfig.ArgonMemory == argonMemory);
+
+    if (xla && rx0) {
+        CHECK(hash(xla) == kHashXla);
+        CHECK(hash(rx0) == kHashRx0);
+        CHECK(hash(xla, 7) == kHashXla);
+        CHECK(!xlarig_verifier_is_full(xla));
+    }
+
+    xlarig_verifier_destroy(rx0);
+    xlarig_verifier_destroy(xla);
+
+    CHECK(minerHash(Algorithm::RX_0) == kHashRx0);
+    CHECK(RandomX_CurrentConfig.ArgonMemory == argonMemory);
+}
+
+
+static void testFull()
+{
+    auto verifier = create("panthera", XLARIG_VERIFY_MODE_FULL);
+    CHECK(verifier);
+
+    if (verifier) {
+        CHECK(xlarig_verifier_is_full(verifier));
+        CHECK(hash(verifier, 5) == kHashXla);
+    }
+
+    xlarig_verifier_destroy(verifier);
+}
+
+
+// A batch at the threshold starts the build without waiting for it, a later batch picks up the dataset.
+static void testAuto()
+{
+    auto verifier = create("panthera", XLARIG_VERIFY_MODE_AUTO, 2, 4);
+    CHECK(verifier);
+    if (!verifier) {
+        return;
+    }
+
+    CHECK(hash(verifier, 1) == kHashXla);
+    CHECK(!xlarig_verifier_is_full(verifier));
+    CHECK(hash(verifier, 4) == kHashXla);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+    while (!xlarig_verifier_is_full(verifier) && std::chrono::steady_clock::now() < deadline) {
+        CHECK(hash(verifier, 1) == kHashXla);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    CHECK(xlarig_verifier_is_full(verifier));
+    CHECK(hash(verifier, 4) == kHashXla);
+
+    xlarig_verifier_destroy(verifier);
+}
+
+
+static void testErrors()
+{
+    CHECK(!xlarig_verifier_create("cn/0", kKey, sizeof(kKey) - 1, nullptr));
+    CHECK(!xlarig_verifier_create("panthera", kKey, 0, nullptr));
+    CHECK(xlarig_verifier_hash(nullptr, nullptr, 0, nullptr) == XLARIG_VERIFY_ERR_ARGS);
+
+    auto verifier = create("panthera", XLARIG_VERIFY_MODE_LIGHT, 1);
+    CHECK(verifier);
+    if (!verifier) {
+        return;
+    }
+
+    uint8_t hashes[XLARIG_VERIFY_HASH_SIZE * 2];
+    xlarig_verify_item items[2] = { item(), item() };
+
+    CHECK(xlarig_verifier_hash(verifier, nullptr, 1, hashes) == XLARIG_VERIFY_ERR_ARGS);
+
+    items[1].size = XLARIG_VERIFY_NONCE_OFFSET + 3;
+    CHECK(xlarig_verifier_hash(verifier, items, 2, hashes) == XLARIG_VERIFY_ERR_BLOB_SIZE);
+
+    items[1].size = 4096;
+    CHECK(xlarig_verifier_hash(verifier, items, 2, hashes) == XLARIG_VERIFY_ERR_BLOB_SIZE);
+
+    items[1] = item();
+    items[1].blob = nullptr;
+    CHECK(xlarig_verifier_hash(verifier, items, 2, hashes) == XLARIG_VERIFY_ERR_BLOB_SIZE);
+
+#   ifdef __linux__
+    // The worker allocates its scratchpad on the first batch, with no address space left it can't create a VM.
+    rlimit limit{};
+    getrlimit(RLIMIT_AS, &limit);
+
+    rlimit tight = limit;
+    tight.rlim_cur = 1;
+
+    items[1] = item();
+
+    if (setrlimit(RLIMIT_AS, &tight) == 0) {
+        const int status = xlarig_verifier_hash(verifier, items, 2, hashes);
+        setrlimit(RLIMIT_AS, &limit);
+
+        CHECK(status == XLARIG_VERIFY_ERR_MEMORY);
+    }
+#   endif
+
+    // The failed worker retries on the next batch.
+    CHECK(hash(verifier) == kHashXla);
+
+    xlarig_verifier_destroy(verifier);
+}
+
+
+} // namespace xmrig
+
+
+int main()
+{
+    using namespace xmrig;
+
+    testErrors();
+    testKnownAnswers();
+    testFull();
+    testAuto();
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+
+        return 1;
+    }
+
+    printf("all checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "verify/xlarig-verify.h"
+#include "verify/Verifier.h"
+
+
+struct xlarig_verifier
+{
+    xmrig::Verifier *verifier;
+};
+
+
+extern "C" {
+
+
+void xlarig_verify_options_init(xlarig_verify_options *options)
+{
+    if (!options) {
+        return;
+    }
+
+    options->threads        = 0;
+    options->mode           = XLARIG_VERIFY_MODE_AUTO;
+    options->full_threshold = 256;
+    options->huge_pages     = 1;
+    options->affinity       = 1;
+}
+
+
+xlarig_verifier *xlarig_verifier_create(const char *algo, const void *seed, size_t seed_size, const xlarig_verify_options *options)
+{
+    if (!algo || !seed || !seed_size) {
+        return nullptr;
+    }
+
+    xlarig_verify_options defaults;
+    xlarig_verify_options_init(&defaults);
+
+    const auto data = static_cast<const uint8_t *>(seed);
+    auto verifier   = new xmrig::Verifier(algo, xmrig::Buffer(data, data + seed_size), options ? *options : defaults);
+
+    if (!verifier->isValid()) {
+        delete verifier;
+
+        return nullptr;
+    }
+
+    return new xlarig_verifier{ verifier };
+}
+
+
+int xlarig_verifier_hash(xlarig_verifier *verifier, const xlarig_verify_item *items, size_t count, void *hashes)
+{
+    if (!verifier) {
+        return XLARIG_VERIFY_ERR_ARGS;
+    }
+
+    return verifier->verifier->hash(items, count, static_cast<uint8_t *>(hashes));
+}
+
+
+int xlarig_verifier_is_full(const xlarig_verifier *verifier)
+{
+    return verifier && verifier->verifier->isFull() ? 1 : 0;
+}
+
+
+void xlarig_verifier_destroy(xlarig_verifier *verifier)
+{
+    if (!verifier) {
+        return;
+    }
+
+    delete verifier->verifier;
+    delete verifier;
+}
+
+
+} // extern "C"
@@ -0,0 +1,107 @@
+/* XMRig
+ * Copyright 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ * Copyright 2018-2021 The Scala Project Team  <https://github.com/scala-network>, <hello@scalaproject.io>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XLARIG_VERIFY_H
+#define XLARIG_VERIFY_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define XLARIG_VERIFY_HASH_SIZE     32
+#define XLARIG_VERIFY_NONCE_OFFSET  39
+
+
+typedef enum {
+    XLARIG_VERIFY_MODE_AUTO  = 0,   /* start in light mode, a batch of full_threshold items starts a background dataset build */
+    XLARIG_VERIFY_MODE_LIGHT = 1,   /* cache only, its size depends on the algorithm: 256 MB for rx/0, 128 MB for rx/xla (panthera) */
+    XLARIG_VERIFY_MODE_FULL  = 2    /* cache and dataset built on create: 2080 MB dataset for rx/0, 64 MB for rx/xla */
+} xlarig_verify_mode;
+
+
+typedef enum {
+    XLARIG_VERIFY_OK             =  0,
+    XLARIG_VERIFY_ERR_ARGS       = -1,
+    XLARIG_VERIFY_ERR_BLOB_SIZE  = -2,
+    XLARIG_VERIFY_ERR_MEMORY     = -3   /* no worker could allocate a RandomX VM, hashes are not filled, retried on the next batch */
+} xlarig_verify_status;
+
+
+typedef struct {
+    unsigned threads;               /* worker threads, 0 = one per logical CPU */
+    int mode;                       /* xlarig_verify_mode */
+    size_t full_threshold;          /* minimal batch size that switches AUTO mode to the full dataset */
+    int huge_pages;                 /* use huge pages for the cache, dataset and scratchpads */
+    int affinity;                   /* pin worker threads to logical CPUs */
+} xlarig_verify_options;
+
+
+typedef struct {
+    const void *blob;               /* hashing blob, at least XLARIG_VERIFY_NONCE_OFFSET + 4 bytes */
+    size_t size;
+    uint32_t nonce;                 /* written into the blob copy at XLARIG_VERIFY_NONCE_OFFSET */
+} xlarig_verify_item;
+
+
+typedef struct xlarig_verifier xlarig_verifier;
+
+
+/*
+ * Fills options with the defaults: all logical CPUs, AUTO mode, huge pages and affinity enabled.
+ */
+void xlarig_verify_options_init(xlarig_verify_options *options);
+
+/*
+ * Creates a verifier for RandomX family algorithm (for example "panthera") and seed hash.
+ * Returns NULL if the algorithm is unknown or the cache can't be allocated.
+ * Every verifier keeps its own variant parameters, so verifiers for different variants can live side by side
+ * and the RandomX configuration of other code in the process is not changed.
+ */
+xlarig_verifier *xlarig_verifier_create(const char *algo, const void *seed, size_t seed_size, const xlarig_verify_options *options);
+
+/*
+ * Calculates hashes for a batch of items, hashes must point to count * XLARIG_VERIFY_HASH_SIZE bytes.
+ * Safe to call from multiple threads, batches submitted to the same verifier are processed one by one.
+ * In AUTO mode a dataset built in the background replaces the cache between two batches, calls never wait for the build.
+ */
+int xlarig_verifier_hash(xlarig_verifier *verifier, const xlarig_verify_item *items, size_t count, void *hashes);
+
+/*
+ * Returns non-zero if the verifier currently uses the full dataset.
+ */
+int xlarig_verifier_is_full(const xlarig_verifier *verifier);
+
+/*
+ * Waits for a background dataset build if one is running.
+ */
+void xlarig_verifier_destroy(xlarig_verifier *verifier);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* XLARIG_VERIFY_H */